@@ -12,15 +12,32 @@ if (!(Test-Path "build")) {
 $sources = @(
     "src/StateValidator.cpp",
     "src/Stack.cpp",
+    "src/VehicleIdPool.cpp",
+    "src/TimingWheel.cpp",
+    "src/IndexedMinHeap.cpp",
+    "src/ReservationCalendar.cpp",
+    "src/FallbackStats.cpp",
+    "src/Bitmap.cpp",
+    "src/SlotKernels.cpp",
+    "src/OccupancyCounter.cpp",
+    "src/SlotTable.cpp",
     "src/ParkingSlot.cpp",
     "src/ParkingArea.cpp",
     "src/Zone.cpp",
+    "src/ZoneGraph.cpp",
+    "src/SlotDirectory.cpp",
     "src/Vehicle.cpp",
     "src/ParkingRequest.cpp",
+    "src/VehicleIndex.cpp",
+    "src/RequestTable.cpp",
     "src/RollbackManager.cpp",
+    "src/MinCostFlow.cpp",
     "src/AllocationEngine.cpp",
     "src/AnalyticsEngine.cpp",
     "src/ParkingSystem.cpp",
+    "src/GateIngest.cpp",
+    "src/WorkStealingPool.cpp",
+    "src/ZoneActorSystem.cpp",
     "src/main.cpp"
 )
 
@@ -28,7 +45,7 @@ $output = "build/parking_system.exe"
 $includes = "-Iinclude"
 
 Write-Host "Compiling with g++..." -ForegroundColor Yellow
-$command = "g++ -std=c++17 $includes $($sources -join ' ') -o $output"
+$command = "g++ -std=c++17 -pthread $includes $($sources -join ' ') -o $output"
 
 try {
     Invoke-Expression $command
@@ -1,10 +1,39 @@
 #include "include/AllocationEngine.h"
 #include "include/ParkingSystem.h"
 #include "include/RollbackManager.h"
+#include "include/MinCostFlow.h"
+#include "include/AllocationPolicies.h"
 #include <iostream>
+#include <atomic>
+#include <ctime>
+
+struct AllocationEngine::ZoneBatchTask {
+    AllocationEngine* engine;
+    ParkingRequest** requests;      // This group's FIFO run
+    ParkingSlot** slotBuffer;       // This group's slice of the batch buffer
+    int zoneId;
+    int count;
+    int remaining;
+    int nextFallback;               // Next fallback-list entry the spill task tries
+    int sameZone;
+    int crossZone;
+    float penaltyCost;
+    std::atomic<int>* ownZonePending;   // Own-zone tasks not yet finished
+    ZoneBatchTask* groups;
+    int groupCount;
+};
 
 AllocationEngine::AllocationEngine(ParkingSystem* system, RollbackManager* rbManager) 
-    : parkingSystem(system), rollbackManager(rbManager), crossZonePenalty(1.5f) {}
+    : parkingSystem(system), rollbackManager(rbManager), crossZonePenalty(1.5f),
+      maxFallbackHops(-1), maxFallbackCost(-1), batchMode(BATCH_GREEDY), slotPolicy(POLICY_FIRST_FIT),
+      fallbackPolicy(FALLBACK_NEAREST), workerPool(nullptr), fallbackHour(-1), wastedProbes(0),
+      negativeCacheSkips(0) {}
+
+bool AllocationEngine::withinFallbackLimits(const ZoneFallback& fallback) const {
+    if (maxFallbackHops >= 0 && fallback.hops > maxFallbackHops) return false;
+    if (maxFallbackCost >= 0 && fallback.cost > maxFallbackCost) return false;
+    return true;
+}
 
 bool AllocationEngine::allocateSlot(ParkingRequest* request) {
     if (request == nullptr || request->getState() != REQUESTED) {
@@ -15,49 +44,451 @@ bool AllocationEngine::allocateSlot(ParkingRequest* request) {
     int requestedZoneId = request->getRequestedZoneId();
     
     // Step 1: Try same zone first
-    ParkingSlot* slot = findSlotInZone(requestedZoneId);
+    ParkingSlot* slot = claimSlotInZone(parkingSystem->getZoneById(requestedZoneId), request, false);
     
     if (slot != nullptr) {
-        // Same-zone allocation
-        slot->allocate(request->getVehicleId());
-        request->allocateSlot(slot->getSlotId(), false);
-        
         // Log for rollback
-        rollbackManager->logAllocation(slot->getSlotId(), 
-                                       request->getVehicleId(), 
-                                       REQUESTED);
+        rollbackManager->logAllocation(request, REQUESTED);
         
-        std::cout << "Allocated slot " << slot->getSlotId() 
-                  << " in requested zone " << requestedZoneId << std::endl;
+        if (parkingSystem->isVerbose()) {
+            std::cout << "Allocated slot " << slot->getSlotId() 
+                      << " in requested zone " << requestedZoneId << std::endl;
+        }
         return true;
     }
     
     // Step 2: Try adjacent zones
-    slot = findSlotInAdjacentZones(requestedZoneId);
+    slot = claimSlotInAdjacentZones(request);
     
     if (slot != nullptr) {
-        // Cross-zone allocation
-        slot->allocate(request->getVehicleId());
-        request->allocateSlot(slot->getSlotId(), true);
-        
         // Log for rollback
-        rollbackManager->logAllocation(slot->getSlotId(), 
-                                       request->getVehicleId(), 
-                                       REQUESTED);
+        rollbackManager->logAllocation(request, REQUESTED);
         
-        std::cout << "Allocated slot " << slot->getSlotId() 
-                  << " in zone " << slot->getZoneId()
-                  << " (cross-zone from " << requestedZoneId << ")"
-                  << " with " << (crossZonePenalty * 100) << "% penalty" << std::endl;
+        if (parkingSystem->isVerbose()) {
+            std::cout << "Allocated slot " << slot->getSlotId() 
+                      << " in zone " << slot->getZoneId()
+                      << " (cross-zone from " << requestedZoneId << ")"
+                      << " with " << (crossZonePenalty * 100) << "% penalty" << std::endl;
+        }
         return true;
     }
     
-    std::cout << "No available slots found in zone " << requestedZoneId 
-              << " or adjacent zones" << std::endl;
+    if (parkingSystem->isVerbose()) {
+        std::cout << "No available slots found in zone " << requestedZoneId 
+                  << " or adjacent zones" << std::endl;
+    }
     return false;
 }
 
-bool AllocationEngine::cancelAllocation(ParkingRequest* request) {
+void AllocationEngine::commitAllocation(Zone* zone, ParkingRequest* request, ParkingSlot* slot,
+                                        bool isCrossZone) {
+    int length = request->getSlotCount();
+    if (length > 1) {
+        slot->getArea()->allocateRun(slot->getSlotIndex(), length, request->getVehicleHandle());
+    } else {
+        slot->allocate(request->getVehicleHandle());
+    }
+    request->allocateSlot(slot->getSlotId(), isCrossZone, slot->getSlotHandle());
+    zone->chargeClass(request->getRequestClass(), length);
+    request->setClassCharged(true);
+    parkingSystem->armNoShowTimer(request);
+}
+
+int AllocationEngine::fillFromZone(Zone* zone, ParkingRequest** requests, int count,
+                                   ParkingSlot** slotBuffer, bool isCrossZone) {
+    if (zone == nullptr || count <= 0) return 0;
+    
+    std::lock_guard<Zone> guard(*zone);
+    int found = zone->collectAvailableSlots(slotBuffer, count);
+    
+    // Placed requests move to the front in order; requests their class may
+    // not place here (reserved capacity), or whose required attributes or run
+    // no free slots have, keep their order behind them. Unconstrained first-fit
+    // requests take the collected slots in order; the rest go through the slot
+    // policy, so a collected slot may already be gone when its turn comes.
+    ParkingRequest** refused = nullptr;
+    int refusedCount = 0;
+    int placed = 0;
+    int cursor = 0;
+    int next = 0;
+    for (; next < count; next++) {
+        ParkingRequest* request = requests[next];
+        unsigned int required = request->getRequiredAttributes();
+        int length = request->getSlotCount();
+        while (cursor < found && !slotBuffer[cursor]->isAvailable()) {
+            cursor++;
+        }
+        if (cursor >= found && zone->getAreasWithCapacityCount() == 0) break;
+        
+        ParkingSlot* slot = nullptr;
+        if (zone->admits(request->getRequestClass(), walkInHoldback(zone, request) + length - 1)) {
+            if (required != 0 || length > 1 || slotPolicy != POLICY_FIRST_FIT) {
+                slot = selectSlot(zone, request);
+            } else if (cursor < found) {
+                slot = slotBuffer[cursor++];
+            }
+        }
+        if (slot == nullptr) {
+            if (refused == nullptr) refused = new ParkingRequest*[count];
+            refused[refusedCount++] = request;
+            continue;
+        }
+        commitAllocation(zone, request, slot, isCrossZone);
+        requests[placed++] = request;
+    }
+    for (int i = 0; i < refusedCount; i++) {
+        requests[placed + i] = refused[i];
+    }
+    delete[] refused;
+    return placed;
+}
+
+BatchAllocationResult AllocationEngine::allocateBatch(Queue<ParkingRequest*>& pending) {
+    return allocateBatch(&pending, 1);
+}
+
+BatchAllocationResult AllocationEngine::allocateBatch(Queue<ParkingRequest*>* levels, int levelCount) {
+    BatchAllocationResult result;
+    
+    // Drain the levels highest first, keeping only requests still waiting for a slot
+    int drained = 0;
+    for (int level = 0; level < levelCount; level++) {
+        drained += levels[level].getSize();
+    }
+    if (drained == 0) return result;
+    
+    ParkingRequest** batch = new ParkingRequest*[drained];
+    int* groupOf = new int[drained];
+    DynamicArray<int> groupZoneIds;
+    DynamicArray<int> groupSizes;
+    int count = 0;
+    
+    for (int level = levelCount - 1; level >= 0; level--) {
+        Queue<ParkingRequest*>& pending = levels[level];
+        while (!pending.isEmpty()) {
+            ParkingRequest* request = pending.dequeue();
+            if (request == nullptr || !request->isQueued()) {
+                // Recycled or duplicate entry
+                result.skipped++;
+                continue;
+            }
+            request->setQueued(false);
+            if (request->getState() != REQUESTED) {
+                result.skipped++;
+                continue;
+            }
+        
+            // Group by requested zone (few distinct zones per batch; last hit is cached)
+            int zoneId = request->getRequestedZoneId();
+            int group = (count > 0 && groupZoneIds[groupOf[count - 1]] == zoneId) ? groupOf[count - 1] : -1;
+            for (int g = 0; group < 0 && g < groupZoneIds.getSize(); g++) {
+                if (groupZoneIds[g] == zoneId) group = g;
+            }
+            if (group < 0) {
+                group = groupZoneIds.getSize();
+                groupZoneIds.add(zoneId);
+                groupSizes.add(0);
+            }
+            groupSizes[group]++;
+            groupOf[count] = group;
+            batch[count++] = request;
+        }
+    }
+    result.processed = count;
+    
+    // Stable counting sort into per-zone runs (drain order - class, then FIFO - within each zone)
+    int groupCount = groupZoneIds.getSize();
+    int* zoneIds = new int[groupCount + 1];
+    int* groupStart = new int[groupCount + 1];
+    int* cursor = new int[groupCount + 1];
+    groupStart[0] = 0;
+    for (int g = 0; g < groupCount; g++) {
+        zoneIds[g] = groupZoneIds[g];
+        groupStart[g + 1] = groupStart[g] + groupSizes[g];
+        cursor[g] = groupStart[g];
+    }
+    ParkingRequest** ordered = new ParkingRequest*[count > 0 ? count : 1];
+    for (int i = 0; i < count; i++) {
+        ordered[cursor[groupOf[i]]++] = batch[i];
+    }
+    
+    ParkingSlot** slotBuffer = new ParkingSlot*[count > 0 ? count : 1];
+    if (batchMode == BATCH_MIN_COST) {
+        assignMinCost(ordered, zoneIds, groupStart, groupCount, slotBuffer, result);
+    } else if (workerPool != nullptr) {
+        assignParallel(ordered, zoneIds, groupStart, groupCount, slotBuffer, result);
+    } else {
+        assignGreedy(ordered, zoneIds, groupStart, groupCount, slotBuffer, result);
+    }
+    
+    // Log every allocation in one rollback batch, re-queue the rest
+    int logged = 0;
+    for (int i = 0; i < count; i++) {
+        if (ordered[i]->getState() == ALLOCATED) {
+            batch[logged++] = ordered[i];
+        } else {
+            ordered[i]->setQueued(true);
+            levels[levelCount == 1 ? 0 : ordered[i]->getRequestClass()].enqueue(ordered[i]);
+            result.requeued++;
+        }
+    }
+    rollbackManager->logAllocationBatch(batch, logged, REQUESTED);
+    
+    delete[] batch;
+    delete[] groupOf;
+    delete[] zoneIds;
+    delete[] groupStart;
+    delete[] cursor;
+    delete[] ordered;
+    delete[] slotBuffer;
+    return result;
+}
+
+void AllocationEngine::assignGreedy(ParkingRequest** requests, const int* groupZoneIds, 
+                                    const int* groupStart, int groupCount, 
+                                    ParkingSlot** slotBuffer, BatchAllocationResult& result) {
+    int* remaining = new int[groupCount + 1];
+    
+    // Pass 1: every zone serves its own group first
+    for (int g = 0; g < groupCount; g++) {
+        int size = groupStart[g + 1] - groupStart[g];
+        Zone* zone = parkingSystem->getZoneById(groupZoneIds[g]);
+        int filled = fillFromZone(zone, requests + groupStart[g], size, slotBuffer, false);
+        result.sameZone += filled;
+        remaining[g] = size - filled;
+    }
+    
+    // Pass 2: overflow spills along each zone's distance-ordered fallback list
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    for (int g = 0; g < groupCount; g++) {
+        if (remaining[g] == 0) continue;
+        int source = graph->findZoneIndex(groupZoneIds[g]);
+        if (source < 0) continue;
+        
+        const ZoneFallback* fallbacks = graph->getFallbacks(source);
+        int fallbackCount = graph->getFallbackCount(source);
+        for (int f = 0; f < fallbackCount && remaining[g] > 0; f++) {
+            if (maxFallbackCost >= 0 && fallbacks[f].cost > maxFallbackCost) break;
+            if (!withinFallbackLimits(fallbacks[f])) continue;
+            
+            Zone* adjacent = graph->getZone(fallbacks[f].zoneIndex);
+            ParkingRequest** waiting = requests + groupStart[g + 1] - remaining[g];
+            int filled = fillFromZone(adjacent, waiting, remaining[g], slotBuffer, true);
+            result.crossZone += filled;
+            result.penaltyCost += filled * crossZonePenalty * fallbacks[f].cost;
+            remaining[g] -= filled;
+        }
+    }
+    
+    delete[] remaining;
+}
+
+void AllocationEngine::assignParallel(ParkingRequest** requests, const int* groupZoneIds, 
+                                      const int* groupStart, int groupCount, 
+                                      ParkingSlot** slotBuffer, BatchAllocationResult& result) {
+    if (groupCount == 0) return;
+    
+    // Same placement rules as assignGreedy, but each zone's group is its own task
+    std::atomic<int> ownZonePending(groupCount);
+    ZoneBatchTask* tasks = new ZoneBatchTask[groupCount];
+    for (int g = 0; g < groupCount; g++) {
+        tasks[g].engine = this;
+        tasks[g].requests = requests + groupStart[g];
+        tasks[g].slotBuffer = slotBuffer + groupStart[g];
+        tasks[g].zoneId = groupZoneIds[g];
+        tasks[g].count = groupStart[g + 1] - groupStart[g];
+        tasks[g].remaining = tasks[g].count;
+        tasks[g].nextFallback = 0;
+        tasks[g].sameZone = 0;
+        tasks[g].crossZone = 0;
+        tasks[g].penaltyCost = 0.0f;
+        tasks[g].ownZonePending = &ownZonePending;
+        tasks[g].groups = tasks;
+        tasks[g].groupCount = groupCount;
+    }
+    for (int g = 0; g < groupCount; g++) {
+        workerPool->submit(runOwnZoneTask, &tasks[g]);
+    }
+    workerPool->waitIdle();
+    
+    for (int g = 0; g < groupCount; g++) {
+        result.sameZone += tasks[g].sameZone;
+        result.crossZone += tasks[g].crossZone;
+        result.penaltyCost += tasks[g].penaltyCost;
+    }
+    delete[] tasks;
+}
+
+void AllocationEngine::runOwnZoneTask(void* context, WorkStealingPool* pool, int worker) {
+    ZoneBatchTask* task = (ZoneBatchTask*)context;
+    AllocationEngine* engine = task->engine;
+    
+    Zone* zone = engine->parkingSystem->getZoneById(task->zoneId);
+    task->sameZone = engine->fillFromZone(zone, task->requests, task->count, task->slotBuffer, false);
+    task->remaining = task->count - task->sameZone;
+    
+    // Every zone serves its own group before any overflow spills, so the
+    // last own-zone task to finish releases the spill follow-ups
+    if (task->ownZonePending->fetch_sub(1) == 1) {
+        for (int g = 0; g < task->groupCount; g++) {
+            if (task->groups[g].remaining > 0) {
+                pool->spawn(worker, runSpillTask, &task->groups[g]);
+            }
+        }
+    }
+}
+
+void AllocationEngine::runSpillTask(void* context, WorkStealingPool* pool, int worker) {
+    ZoneBatchTask* task = (ZoneBatchTask*)context;
+    AllocationEngine* engine = task->engine;
+    ZoneGraph* graph = engine->parkingSystem->getZoneGraph();
+    int source = graph->findZoneIndex(task->zoneId);
+    if (source < 0) return;
+    
+    const ZoneFallback* fallbacks = graph->getFallbacks(source);
+    int fallbackCount = graph->getFallbackCount(source);
+    while (task->nextFallback < fallbackCount) {
+        const ZoneFallback& fallback = fallbacks[task->nextFallback++];
+        if (engine->maxFallbackCost >= 0 && fallback.cost > engine->maxFallbackCost) return;
+        if (!engine->withinFallbackLimits(fallback)) continue;
+        
+        ParkingRequest** waiting = task->requests + task->count - task->remaining;
+        int filled = engine->fillFromZone(graph->getZone(fallback.zoneIndex), waiting, 
+                                          task->remaining, task->slotBuffer, true);
+        task->crossZone += filled;
+        task->penaltyCost += filled * engine->crossZonePenalty * fallback.cost;
+        task->remaining -= filled;
+        
+        // One zone per task; the next hop is a follow-up so no shard locks nest
+        if (task->remaining > 0 && task->nextFallback < fallbackCount) {
+            pool->spawn(worker, runSpillTask, task);
+        }
+        return;
+    }
+}
+
+void AllocationEngine::assignMinCost(ParkingRequest** requests, const int* groupZoneIds, 
+                                     const int* groupStart, int groupCount, 
+                                     ParkingSlot** slotBuffer, BatchAllocationResult& result) {
+    // Network: source -> request group -> zone -> sink.
+    // Group capacity is its size; a group -> zone edge carries as many of the
+    // group's requests as the zone would admit (class reserves, reservation
+    // holdback, attributes, run length) and costs crossZonePenalty x path cost
+    // (0 for its own zone); a zone's capacity is the most any request sent to
+    // it may take. Slots within a zone are interchangeable for requests alike,
+    // so the network stays groups + zones in size however many requests the
+    // batch holds. Mixed groups make these bounds loose, and fillFromZone
+    // re-checks each request, so an over-planned request is re-queued.
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    int zoneCount = graph->getZoneCount();
+    int source = 0;
+    int sink = 1 + groupCount + zoneCount;
+    MinCostFlow flow(sink + 1);
+    
+    int* zoneCapacity = new int[zoneCount > 0 ? zoneCount : 1];   // -1 = no edge into the zone
+    for (int z = 0; z < zoneCount; z++) {
+        zoneCapacity[z] = -1;
+    }
+    DynamicArray<int> assignEdges;      // Group -> zone edges, in fallback order per group
+    DynamicArray<int> assignGroup;
+    DynamicArray<int> assignZone;
+    DynamicArray<int> assignCost;       // Path cost (0 for same-zone)
+    
+    for (int g = 0; g < groupCount; g++) {
+        int zoneIndex = graph->findZoneIndex(groupZoneIds[g]);
+        if (zoneIndex < 0) continue;
+        flow.addEdge(source, 1 + g, groupStart[g + 1] - groupStart[g], 0);
+        
+        const ZoneFallback* fallbacks = graph->getFallbacks(zoneIndex);
+        int fallbackCount = graph->getFallbackCount(zoneIndex);
+        for (int f = -1; f < fallbackCount; f++) {
+            int target = zoneIndex;
+            int cost = 0;
+            if (f >= 0) {
+                if (maxFallbackCost >= 0 && fallbacks[f].cost > maxFallbackCost) break;
+                if (!withinFallbackLimits(fallbacks[f])) continue;
+                target = fallbacks[f].zoneIndex;
+                cost = fallbacks[f].cost;
+            }
+            
+            int eligible = 0;
+            int admissible = countAdmissible(graph->getZone(target), requests + groupStart[g],
+                                             groupStart[g + 1] - groupStart[g], eligible);
+            if (admissible > zoneCapacity[target]) zoneCapacity[target] = admissible;
+            if (eligible == 0) continue;
+            
+            // Scaled to integers; same-zone edges stay free
+            long long edgeCost = (long long)(crossZonePenalty * 100.0f) * cost;
+            assignEdges.add(flow.addEdge(1 + g, 1 + groupCount + target, 
+                                         eligible < admissible ? eligible : admissible, edgeCost));
+            assignGroup.add(g);
+            assignZone.add(target);
+            assignCost.add(cost);
+        }
+    }
+    
+    for (int z = 0; z < zoneCount; z++) {
+        if (zoneCapacity[z] > 0) flow.addEdge(1 + groupCount + z, sink, zoneCapacity[z], 0);
+    }
+    
+    long long totalCost = 0;
+    flow.solve(source, sink, totalCost);
+    
+    // Hand out slots: per group, own zone first, then nearer fallbacks, FIFO
+    int* placed = new int[groupCount + 1];
+    for (int g = 0; g < groupCount; g++) {
+        placed[g] = 0;
+    }
+    for (int a = 0; a < assignEdges.getSize(); a++) {
+        int amount = flow.getFlow(assignEdges[a]);
+        if (amount <= 0) continue;
+        
+        int g = assignGroup[a];
+        bool isCrossZone = assignZone[a] != graph->findZoneIndex(groupZoneIds[g]);
+        ParkingRequest** waiting = requests + groupStart[g] + placed[g];
+        int filled = fillFromZone(graph->getZone(assignZone[a]), waiting, amount, slotBuffer, isCrossZone);
+        placed[g] += filled;
+        if (isCrossZone) {
+            result.crossZone += filled;
+            result.penaltyCost += filled * crossZonePenalty * assignCost[a];
+        } else {
+            result.sameZone += filled;
+        }
+    }
+    
+    delete[] zoneCapacity;
+    delete[] placed;
+}
+
+int AllocationEngine::countAdmissible(Zone* zone, ParkingRequest** requests, int count, int& eligible) {
+    // Per request: how many requests like it the zone would still take, as
+    // fillFromZone's admission and search see it; the largest bounds the zone
+    std::lock_guard<Zone> guard(*zone);
+    int most = 0;
+    eligible = 0;
+    unsigned int countedMask = 0;
+    int matching = 0;
+    for (int i = 0; i < count; i++) {
+        ParkingRequest* request = requests[i];
+        int length = request->getSlotCount();
+        int slots = zone->getAdmissibleSlots(request->getRequestClass(), walkInHoldback(zone, request));
+        unsigned int required = request->getRequiredAttributes();
+        if (required != 0) {
+            // Groups are usually one kind of request, so one count serves the run
+            if (required != countedMask) {
+                matching = zone->countAvailableSlots(required);
+                countedMask = required;
+            }
+            if (matching < slots) slots = matching;
+        }
+        int fits = slots / length;
+        if (fits > 0) eligible++;
+        if (fits > most) most = fits;
+    }
+    return most;
+}
+
+bool AllocationEngine::cancelAllocation(ParkingRequest* request, bool zoneOwned) {
     if (request == nullptr) {
         return false;
     }
@@ -71,35 +502,182 @@ bool AllocationEngine::cancelAllocation(ParkingRequest* request) {
     
     // If slot was allocated, free it
     if (state == ALLOCATED) {
-        int slotId = request->getAllocatedSlotId();
-        ParkingSlot* slot = parkingSystem->findSlotById(slotId);
-        if (slot != nullptr) {
-            slot->release();
-        }
+        parkingSystem->releaseRequestSlot(request, zoneOwned);
     }
     
     return request->cancel();
 }
 
-ParkingSlot* AllocationEngine::findSlotInZone(int zoneId) {
-    Zone* zone = parkingSystem->getZoneById(zoneId);
-    if (zone == nullptr) {
+ParkingSlot* AllocationEngine::allocateInZone(ParkingRequest* request, Zone* zone, bool isCrossZone) {
+    if (request == nullptr || request->getState() != REQUESTED) {
         return nullptr;
     }
     
-    return zone->findAvailableSlot();
+    ParkingSlot* slot = claimSlotInZone(zone, request, isCrossZone);
+    if (slot != nullptr) {
+        rollbackManager->logAllocation(request, REQUESTED);
+    }
+    return slot;
 }
 
-ParkingSlot* AllocationEngine::findSlotInAdjacentZones(int requestedZoneId) {
-    Zone* requestedZone = parkingSystem->getZoneById(requestedZoneId);
-    if (requestedZone == nullptr) {
+bool AllocationEngine::allocateReservedSlot(ParkingRequest* request, int slotHandle) {
+    if (request == nullptr || request->getState() != REQUESTED) {
+        return false;
+    }
+    
+    SlotDirectory* directory = parkingSystem->getSlotDirectory();
+    ParkingSlot* slot = directory->getSlot(slotHandle);
+    Zone* zone = directory->getZone(slotHandle);
+    if (slot == nullptr || zone == nullptr) {
+        return false;
+    }
+    
+    // The hold is handed over under the shard lock, so no walk-in sees it free
+    std::lock_guard<Zone> guard(*zone);
+    if (slot->getStatus() != SLOT_RESERVED || !slot->setStatus(SLOT_AVAILABLE)) {
+        return false;
+    }
+    commitAllocation(zone, request, slot, false);
+    rollbackManager->logAllocation(request, REQUESTED);
+    return true;
+}
+
+int AllocationEngine::walkInHoldback(Zone* zone, const ParkingRequest* request) {
+    // Free slots the zone's not-yet-held reservations need during this stay
+    long long now = time(nullptr);
+    long long stay = request->getBookedDuration();
+    if (stay <= 0) stay = parkingSystem->getDefaultStayDuration();
+    return parkingSystem->getReservationHoldback(zone, now, now + stay);
+}
+
+ParkingSlot* AllocationEngine::selectSlot(Zone* zone, const ParkingRequest* request) {
+    // A search that failed since the zone last freed a slot would fail again
+    unsigned int required = request->getRequiredAttributes();
+    int length = request->getSlotCount();
+    if (zone->isKnownMiss(required, length)) {
         return nullptr;
     }
     
-    // Try each adjacent zone
-    for (int i = 0; i < requestedZone->getAdjacentZoneCount(); i++) {
-        int adjacentZoneId = requestedZone->getAdjacentZone(i);
-        ParkingSlot* slot = findSlotInZone(adjacentZoneId);
+    // One switch per claim; each case is a fully inlined SlotSelector
+    ParkingSlot* slot = nullptr;
+    switch (slotPolicy) {
+        case POLICY_NEXT_FIT:
+            slot = NextFitSelector::select(zone, required, length);
+            break;
+        case POLICY_LEAST_UTILIZED_AREA:
+            slot = LeastUtilizedSelector::select(zone, required, length);
+            break;
+        case POLICY_ROUND_ROBIN_AREAS:
+            slot = RoundRobinSelector::select(zone, required, length);
+            break;
+        default:
+            // Zone search honours its SlotSearchMode
+            slot = zone->findAvailableRun(length, required);
+            break;
+    }
+    if (slot == nullptr) {
+        zone->recordMiss(required, length);
+    }
+    return slot;
+}
+
+ParkingSlot* AllocationEngine::claimSlotInZone(Zone* zone, ParkingRequest* request, bool isCrossZone) {
+    // Unlocked counter reads skip full (or, for this class, fully reserved)
+    // zones without touching their lock
+    RequestClass requestClass = request->getRequestClass();
+    int length = request->getSlotCount();
+    if (zone == nullptr || !zone->admits(requestClass, length - 1)) {
+        return nullptr;
+    }
+    // Same for zones whose last search for these attributes and run length failed
+    if (zone->isKnownMiss(request->getRequiredAttributes(), length)) {
+        if (isCrossZone) negativeCacheSkips.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    // Search and claim under the shard lock so no other thread takes the same slots
+    std::lock_guard<Zone> guard(*zone);
+    ParkingSlot* slot = nullptr;
+    if (zone->admits(requestClass, walkInHoldback(zone, request) + length - 1)) {
+        slot = selectSlot(zone, request);
+    }
+    if (slot != nullptr) {
+        commitAllocation(zone, request, slot, isCrossZone);
+    } else if (isCrossZone) {
+        wastedProbes.fetch_add(1, std::memory_order_relaxed);
+    }
+    return slot;
+}
+
+ParkingSlot* AllocationEngine::claimOwnedSlot(Zone* zone, ParkingRequest* request, bool isCrossZone) {
+    if (request == nullptr || request->getState() != REQUESTED) {
+        return nullptr;
+    }
+    RequestClass requestClass = request->getRequestClass();
+    int length = request->getSlotCount();
+    if (!zone->admits(requestClass, length - 1)) {
+        return nullptr;
+    }
+    
+    // Bookings are written under the shard lock, so the holdback is read under it
+    int holdback;
+    {
+        std::lock_guard<Zone> guard(*zone);
+        holdback = walkInHoldback(zone, request);
+    }
+    if (!zone->admits(requestClass, holdback + length - 1)) {
+        return nullptr;
+    }
+    ParkingSlot* slot = selectSlot(zone, request);
+    if (slot != nullptr) {
+        commitAllocation(zone, request, slot, isCrossZone);
+        rollbackManager->logAllocation(request, REQUESTED);
+    }
+    return slot;
+}
+
+ParkingSlot* AllocationEngine::claimSlotInAdjacentZones(ParkingRequest* request) {
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    int source = graph->findZoneIndex(request->getRequestedZoneId());
+    if (source < 0) {
+        return nullptr;
+    }
+    
+    // Sorted by cost, so the cost limit cuts the list to a prefix
+    const ZoneFallback* fallbacks = graph->getFallbacks(source);
+    int count = graph->getFallbackCount(source);
+    int usable = 0;
+    while (usable < count && (maxFallbackCost < 0 || fallbacks[usable].cost <= maxFallbackCost)) {
+        usable++;
+    }
+    
+    if (fallbackPolicy == FALLBACK_ADAPTIVE) {
+        return claimInLearnedOrder(request, source, fallbacks, usable);
+    }
+    if (fallbackPolicy == FALLBACK_LEAST_UTILIZED) {
+        return claimInFallbackOrder<LeastUtilizedFallback>(request, source, fallbacks, usable);
+    }
+    return claimInFallbackOrder<NearestFallback>(request, source, fallbacks, usable);
+}
+
+template <class FallbackOrder>
+ParkingSlot* AllocationEngine::claimInFallbackOrder(ParkingRequest* request, int source,
+                                                    const ZoneFallback* fallbacks, int count) {
+    // The policy's preferred zone first, then the others nearest first.
+    // Each zone is locked on its own, so fallback never nests shard locks.
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    int preferred = FallbackOrder::preferred(graph, fallbacks, count, maxFallbackHops);
+    if (preferred >= 0) {
+        ParkingSlot* slot = probeFallback(request, source, fallbacks, preferred);
+        if (slot != nullptr) {
+            return slot;
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        if (i == preferred || !withinFallbackLimits(fallbacks[i])) continue;
+        
+        ParkingSlot* slot = probeFallback(request, source, fallbacks, i);
         if (slot != nullptr) {
             return slot;
         }
@@ -108,6 +686,45 @@ ParkingSlot* AllocationEngine::findSlotInAdjacentZones(int requestedZoneId) {
     return nullptr;
 }
 
+ParkingSlot* AllocationEngine::claimInLearnedOrder(ParkingRequest* request, int source,
+                                                   const ZoneFallback* fallbacks, int count) {
+    // Best recent hit rate for this source zone and hour first; zones that
+    // keep coming up empty sink, but are still tried last. The order lives on
+    // the stack unless the fallback list is unusually long.
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    int fallbackCount = graph->getFallbackCount(source);
+    int stackOrder[LEARNED_ORDER_STACK];
+    int* order = fallbackCount <= LEARNED_ORDER_STACK ? stackOrder : new int[fallbackCount];
+    int ordered = fallbackStats.getOrder(source, currentFallbackHour(), graph->getCompileCount(),
+                                         fallbackCount, order);
+    
+    ParkingSlot* slot = nullptr;
+    for (int i = 0; i < ordered && slot == nullptr; i++) {
+        int position = order[i];
+        if (position >= count || !withinFallbackLimits(fallbacks[position])) continue;
+        slot = probeFallback(request, source, fallbacks, position);
+    }
+    
+    if (order != stackOrder) {
+        delete[] order;
+    }
+    return slot;
+}
+
+ParkingSlot* AllocationEngine::probeFallback(ParkingRequest* request, int source,
+                                             const ZoneFallback* fallbacks, int position) {
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    ParkingSlot* slot = claimSlotInZone(graph->getZone(fallbacks[position].zoneIndex), request, true);
+    fallbackStats.record(source, currentFallbackHour(), graph->getCompileCount(),
+                         graph->getFallbackCount(source), position, slot != nullptr);
+    return slot;
+}
+
+int AllocationEngine::currentFallbackHour() const {
+    if (fallbackHour >= 0) return fallbackHour;
+    return (int)((time(nullptr) / 3600) % FallbackStats::HOURS);
+}
+
 void AllocationEngine::setCrossZonePenalty(float penalty) {
     crossZonePenalty = penalty;
 }
@@ -115,3 +732,82 @@ void AllocationEngine::setCrossZonePenalty(float penalty) {
 float AllocationEngine::getCrossZonePenalty() const {
     return crossZonePenalty;
 }
+
+void AllocationEngine::setFallbackLimits(int maxHops, int maxCost) {
+    maxFallbackHops = maxHops;
+    maxFallbackCost = maxCost;
+}
+
+int AllocationEngine::getMaxFallbackHops() const {
+    return maxFallbackHops;
+}
+
+int AllocationEngine::getMaxFallbackCost() const {
+    return maxFallbackCost;
+}
+
+void AllocationEngine::setBatchAssignmentMode(BatchAssignmentMode mode) {
+    batchMode = mode;
+}
+
+BatchAssignmentMode AllocationEngine::getBatchAssignmentMode() const {
+    return batchMode;
+}
+
+void AllocationEngine::setSlotPolicy(SlotPolicy policy) {
+    slotPolicy = policy;
+}
+
+SlotPolicy AllocationEngine::getSlotPolicy() const {
+    return slotPolicy;
+}
+
+void AllocationEngine::setFallbackPolicy(FallbackPolicy policy) {
+    fallbackPolicy = policy;
+}
+
+FallbackPolicy AllocationEngine::getFallbackPolicy() const {
+    return fallbackPolicy;
+}
+
+void AllocationEngine::setFallbackHour(int hour) {
+    fallbackHour = (hour >= 0 && hour < FallbackStats::HOURS) ? hour : -1;
+}
+
+int AllocationEngine::getLearnedFallbackOrder(int zoneId, int hour, DynamicArray<int>& zoneIds) {
+    ZoneGraph* graph = parkingSystem->getZoneGraph();
+    int source = graph->findZoneIndex(zoneId);
+    if (source < 0) return 0;
+    
+    const ZoneFallback* fallbacks = graph->getFallbacks(source);
+    int count = graph->getFallbackCount(source);
+    int* order = new int[count > 0 ? count : 1];
+    int ordered = fallbackStats.getOrder(source, hour, graph->getCompileCount(), count, order);
+    for (int i = 0; i < ordered; i++) {
+        zoneIds.add(graph->getZone(fallbacks[order[i]].zoneIndex)->getZoneId());
+    }
+    delete[] order;
+    return ordered;
+}
+
+void AllocationEngine::clearFallbackStats() {
+    fallbackStats.clear();
+    wastedProbes.store(0);
+    negativeCacheSkips.store(0);
+}
+
+long long AllocationEngine::getWastedProbes() const {
+    return wastedProbes.load(std::memory_order_relaxed);
+}
+
+long long AllocationEngine::getNegativeCacheSkips() const {
+    return negativeCacheSkips.load(std::memory_order_relaxed);
+}
+
+void AllocationEngine::setWorkerPool(WorkStealingPool* pool) {
+    workerPool = pool;
+}
+
+WorkStealingPool* AllocationEngine::getWorkerPool() const {
+    return workerPool;
+}
@@ -4,8 +4,19 @@
 #include <iomanip>
 #include <cstring>
 
-AnalyticsEngine::AnalyticsEngine(LinkedList<TripHistory>* history, DynamicArray<Zone*>* zoneList)
-    : tripHistory(history), zones(zoneList), totalRolledBackOperations(0) {}
+AnalyticsEngine::AnalyticsEngine(LinkedList<TripHistory>* history, DynamicArray<Zone*>* zoneList,
+                                 const OccupancyCounter* cityCounter)
+    : tripHistory(history), zones(zoneList), cityOccupancy(cityCounter),
+      totalRolledBackOperations(0), workerPool(nullptr) {}
+
+void AnalyticsEngine::setWorkerPool(WorkStealingPool* pool) {
+    workerPool = pool;
+}
+
+void AnalyticsEngine::runZoneStatsTask(void* context, WorkStealingPool*, int) {
+    ZoneStatsTask* task = (ZoneStatsTask*)context;
+    task->engine->calculateZoneSpecificStats(task->zone, *task->stats);
+}
 
 long long AnalyticsEngine::calculateTotalDuration(bool completedOnly) {
     long long totalDuration = 0;
@@ -45,16 +56,7 @@ float AnalyticsEngine::calculateZoneUtilization(int zoneId) {
 }
 
 float AnalyticsEngine::calculateSystemUtilization() {
-    int totalSlots = 0;
-    int occupiedSlots = 0;
-    
-    for (int i = 0; i < zones->getSize(); i++) {
-        totalSlots += (*zones)[i]->getTotalSlots();
-        occupiedSlots += (*zones)[i]->getOccupiedSlots();
-    }
-    
-    if (totalSlots == 0) return 0.0f;
-    return (float)occupiedSlots / totalSlots;
+    return cityOccupancy->getUtilization();
 }
 
 int AnalyticsEngine::findPeakUsageZone() {
@@ -112,12 +114,8 @@ SystemAnalytics AnalyticsEngine::getSystemAnalytics() {
     SystemAnalytics analytics;
     
     // Slot statistics
-    analytics.totalSlots = 0;
-    analytics.occupiedSlots = 0;
-    for (int i = 0; i < zones->getSize(); i++) {
-        analytics.totalSlots += (*zones)[i]->getTotalSlots();
-        analytics.occupiedSlots += (*zones)[i]->getOccupiedSlots();
-    }
+    analytics.totalSlots = cityOccupancy->getTotalSlots();
+    analytics.occupiedSlots = cityOccupancy->getUnavailableSlots();
     analytics.availableSlots = analytics.totalSlots - analytics.occupiedSlots;
     analytics.systemUtilization = calculateSystemUtilization();
     
@@ -146,12 +144,31 @@ DynamicArray<ZoneStats> AnalyticsEngine::getZoneStatistics() {
     float maxUtil = 0.0f;
     int peakZoneId = findPeakUsageZone();
     
-    for (int i = 0; i < zones->getSize(); i++) {
-        ZoneStats zoneStats;
-        calculateZoneSpecificStats((*zones)[i], zoneStats);
-        zoneStats.isPeak = (zoneStats.zoneId == peakZoneId);
-        stats.add(zoneStats);
+    int zoneCount = zones->getSize();
+    ZoneStats* computed = new ZoneStats[zoneCount > 0 ? zoneCount : 1];
+    
+    if (workerPool != nullptr && zoneCount > 1) {
+        // Each zone scans the trip history independently
+        ZoneStatsTask* tasks = new ZoneStatsTask[zoneCount];
+        for (int i = 0; i < zoneCount; i++) {
+            tasks[i].engine = this;
+            tasks[i].zone = (*zones)[i];
+            tasks[i].stats = &computed[i];
+            workerPool->submit(runZoneStatsTask, &tasks[i]);
+        }
+        workerPool->waitIdle();
+        delete[] tasks;
+    } else {
+        for (int i = 0; i < zoneCount; i++) {
+            calculateZoneSpecificStats((*zones)[i], computed[i]);
+        }
+    }
+    
+    for (int i = 0; i < zoneCount; i++) {
+        computed[i].isPeak = (computed[i].zoneId == peakZoneId);
+        stats.add(computed[i]);
     }
+    delete[] computed;
     
     return stats;
 }
@@ -0,0 +1,199 @@
+#include "include/Bitmap.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+Bitmap::Bitmap(int bits, bool initialValue)
+    : words(nullptr), bitCount(0), wordCount(0), setCount(0) {
+    resize(bits, initialValue);
+}
+
+Bitmap::~Bitmap() {
+    delete[] words;
+}
+
+int Bitmap::wordsFor(int bits) {
+    return (bits + 63) / 64;
+}
+
+void Bitmap::set(int index) {
+    if (index < 0 || index >= bitCount) return;
+    unsigned long long mask = 1ULL << (index & 63);
+    unsigned long long& word = words[index >> 6];
+    if ((word & mask) == 0) {
+        word |= mask;
+        setCount++;
+    }
+}
+
+void Bitmap::clear(int index) {
+    if (index < 0 || index >= bitCount) return;
+    unsigned long long mask = 1ULL << (index & 63);
+    unsigned long long& word = words[index >> 6];
+    if ((word & mask) != 0) {
+        word &= ~mask;
+        setCount--;
+    }
+}
+
+void Bitmap::assign(int index, bool value) {
+    if (value) {
+        set(index);
+    } else {
+        clear(index);
+    }
+}
+
+void Bitmap::setRange(int fromIndex, int toIndex) {
+    // Sets bits [fromIndex, toIndex) a word at a time
+    if (fromIndex < 0) fromIndex = 0;
+    if (toIndex > bitCount) toIndex = bitCount;
+    
+    int index = fromIndex;
+    while (index < toIndex) {
+        int w = index >> 6;
+        int offset = index & 63;
+        int span = 64 - offset;
+        if (span > toIndex - index) span = toIndex - index;
+        
+        unsigned long long mask = (span == 64) ? ~0ULL : (((1ULL << span) - 1) << offset);
+        setCount += popCount(mask & ~words[w]);
+        words[w] |= mask;
+        index += span;
+    }
+}
+
+bool Bitmap::test(int index) const {
+    if (index < 0 || index >= bitCount) return false;
+    return (words[index >> 6] >> (index & 63)) & 1ULL;
+}
+
+void Bitmap::resize(int bits, bool newBitsValue) {
+    if (bits < 0) bits = 0;
+
+    int newWordCount = wordsFor(bits);
+    if (newWordCount != wordCount) {
+        unsigned long long* newWords = new unsigned long long[newWordCount > 0 ? newWordCount : 1];
+        for (int i = 0; i < newWordCount; i++) {
+            newWords[i] = (i < wordCount) ? words[i] : 0ULL;
+        }
+        delete[] words;
+        words = newWords;
+        wordCount = newWordCount;
+    }
+
+    // Drop bits past the new end so tail bits in the last word stay zero
+    if (bits < bitCount) {
+        for (int i = bits; i < bitCount; i++) {
+            clear(i);
+        }
+        bitCount = bits;
+        return;
+    }
+
+    int oldBitCount = bitCount;
+    bitCount = bits;
+    if (newBitsValue) {
+        setRange(oldBitCount, bitCount);
+    }
+}
+
+int Bitmap::findFirstSet() const {
+    for (int w = 0; w < wordCount; w++) {
+        if (words[w] != 0) {
+            return (w << 6) + countTrailingZeros(words[w]);
+        }
+    }
+    return -1;
+}
+
+int Bitmap::findNextSet(int fromIndex) const {
+    if (fromIndex < 0) fromIndex = 0;
+    if (fromIndex >= bitCount) return -1;
+
+    int w = fromIndex >> 6;
+    unsigned long long word = words[w] & (~0ULL << (fromIndex & 63));
+    while (true) {
+        if (word != 0) {
+            return (w << 6) + countTrailingZeros(word);
+        }
+        if (++w >= wordCount) break;
+        word = words[w];
+    }
+    return -1;
+}
+
+int Bitmap::count() const {
+    return setCount;
+}
+
+int Bitmap::size() const {
+    return bitCount;
+}
+
+bool Bitmap::none() const {
+    return setCount == 0;
+}
+
+int Bitmap::getWordCount() const {
+    return wordCount;
+}
+
+unsigned long long Bitmap::getWord(int wordIndex) const {
+    if (wordIndex < 0 || wordIndex >= wordCount) return 0ULL;
+    return words[wordIndex];
+}
+
+const unsigned long long* Bitmap::getWords() const {
+    return words;
+}
+
+int Bitmap::countTrailingZeros(unsigned long long word) {
+    if (word == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    int n = 0;
+    while ((word & 1ULL) == 0) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+int Bitmap::countLeadingZeros(unsigned long long word) {
+    if (word == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return 63 - (int)index;
+#else
+    int n = 0;
+    while ((word & (1ULL << 63)) == 0) {
+        word <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+int Bitmap::popCount(unsigned long long word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int n = 0;
+    while (word != 0) {
+        word &= word - 1;
+        n++;
+    }
+    return n;
+#endif
+}
@@ -0,0 +1,142 @@
+#include "include/FallbackStats.h"
+
+FallbackStats::FallbackStats() : replacedDirectories(4) {
+    Directory* initial = new Directory();
+    initial->capacity = 0;
+    initial->rows = nullptr;
+    directory.store(initial);
+}
+
+FallbackStats::~FallbackStats() {
+    Directory* current = directory.load();
+    for (int i = 0; i < current->capacity; i++) {
+        Row* row = current->rows[i].load();
+        if (row != nullptr) {
+            delete[] row->entries;
+            delete row;
+        }
+    }
+    delete[] current->rows;
+    delete current;
+    for (int i = 0; i < replacedDirectories.getSize(); i++) {
+        delete[] replacedDirectories[i]->rows;
+        delete replacedDirectories[i];
+    }
+}
+
+bool FallbackStats::ranksBefore(const Entry& a, const Entry& b) {
+    // Compare (a.hits + 1) / (a.probes + 2) with b's without dividing
+    long long left = (long long)(a.hits + 1) * (b.probes + 2);
+    long long right = (long long)(b.hits + 1) * (a.probes + 2);
+    if (left != right) return left > right;
+    return a.position < b.position;
+}
+
+FallbackStats::Row* FallbackStats::findRow(int source, int hour) {
+    if (source < 0 || hour < 0 || hour >= HOURS) return nullptr;
+    int index = source * HOURS + hour;
+
+    // Fast path: the row already exists
+    Directory* current = directory.load(std::memory_order_acquire);
+    if (index < current->capacity) {
+        Row* row = current->rows[index].load(std::memory_order_acquire);
+        if (row != nullptr) return row;
+    }
+
+    std::lock_guard<std::mutex> guard(directoryLock);
+    current = directory.load(std::memory_order_relaxed);
+    if (index >= current->capacity) {
+        int capacity = current->capacity * 2;
+        if (capacity < index + 1) capacity = index + 1;
+        Directory* grown = new Directory();
+        grown->capacity = capacity;
+        grown->rows = new std::atomic<Row*>[capacity];
+        for (int i = 0; i < capacity; i++) {
+            Row* row = i < current->capacity ? current->rows[i].load(std::memory_order_relaxed) : nullptr;
+            grown->rows[i].store(row, std::memory_order_relaxed);
+        }
+        replacedDirectories.add(current);
+        current = grown;
+        directory.store(current, std::memory_order_release);
+    }
+    Row* row = current->rows[index].load(std::memory_order_relaxed);
+    if (row == nullptr) {
+        row = new Row();
+        current->rows[index].store(row, std::memory_order_release);
+    }
+    return row;
+}
+
+void FallbackStats::prepareRow(Row* row, int stamp, int count) {
+    if (row->stamp != stamp || row->count != count) {
+        delete[] row->entries;
+        row->entries = count > 0 ? new Entry[count] : nullptr;
+        for (int i = 0; i < count; i++) {
+            row->entries[i].position = i;
+        }
+        row->stamp = stamp;
+        row->count = count;
+    }
+}
+
+int FallbackStats::getOrder(int source, int hour, int stamp, int count, int* positions) {
+    Row* row = findRow(source, hour);
+    if (row == nullptr || count < 0) return 0;
+
+    std::lock_guard<std::mutex> guard(row->lock);
+    prepareRow(row, stamp, count);
+    for (int i = 0; i < row->count; i++) {
+        positions[i] = row->entries[i].position;
+    }
+    return row->count;
+}
+
+void FallbackStats::record(int source, int hour, int stamp, int count, int position, bool hit) {
+    Row* row = findRow(source, hour);
+    if (row == nullptr || count < 0) return;
+
+    std::lock_guard<std::mutex> guard(row->lock);
+    prepareRow(row, stamp, count);
+    if (position < 0 || position >= row->count) return;
+
+    // Rows are a handful of entries; a linear scan finds the one to update
+    Entry* entries = row->entries;
+    int at = 0;
+    while (entries[at].position != position) {
+        at++;
+    }
+    entries[at].probes++;
+    if (hit) entries[at].hits++;
+    if (entries[at].probes >= WINDOW) {
+        entries[at].probes /= 2;
+        entries[at].hits /= 2;
+    }
+
+    // Only this entry's score changed, so one pass in either direction restores order
+    while (at > 0 && ranksBefore(entries[at], entries[at - 1])) {
+        Entry moved = entries[at];
+        entries[at] = entries[at - 1];
+        entries[at - 1] = moved;
+        at--;
+    }
+    while (at + 1 < row->count && ranksBefore(entries[at + 1], entries[at])) {
+        Entry moved = entries[at];
+        entries[at] = entries[at + 1];
+        entries[at + 1] = moved;
+        at++;
+    }
+}
+
+void FallbackStats::clear() {
+    // Rows stay allocated (a claim may hold one); each is emptied under its lock
+    Directory* current = directory.load(std::memory_order_acquire);
+    for (int i = 0; i < current->capacity; i++) {
+        Row* row = current->rows[i].load(std::memory_order_acquire);
+        if (row == nullptr) continue;
+        std::lock_guard<std::mutex> guard(row->lock);
+        delete[] row->entries;
+        row->entries = nullptr;
+        row->stamp = -1;
+        row->count = 0;
+    }
+}
@@ -0,0 +1,141 @@
+#include "include/GateIngest.h"
+#include "include/ParkingSystem.h"
+#include <cstring>
+
+GateIngest::GateIngest(ParkingSystem* parkingSystem, int capacity)
+    : system(parkingSystem), ring(capacity), running(false), postedCount(0),
+      rejectedCount(0), appliedCount(0), failedCount(0) {}
+
+GateIngest::~GateIngest() {
+    stop();
+}
+
+bool GateIngest::start() {
+    if (running.load() || allocator.joinable()) {
+        return false;
+    }
+    running.store(true);
+    allocator = std::thread(&GateIngest::run, this);
+    return true;
+}
+
+void GateIngest::stop() {
+    if (allocator.joinable()) {
+        running.store(false);
+        allocator.join();
+    }
+    // The allocator thread is gone, so this thread is now the only consumer
+    drain();
+}
+
+int GateIngest::drain() {
+    if (running.load()) {
+        return 0;
+    }
+    int applied = 0;
+    GateEvent event;
+    while (ring.tryPop(event)) {
+        apply(event);
+        applied++;
+    }
+    return applied;
+}
+
+bool GateIngest::isRunning() const {
+    return running.load();
+}
+
+void GateIngest::run() {
+    GateEvent event;
+    while (running.load(std::memory_order_acquire)) {
+        if (ring.tryPop(event)) {
+            apply(event);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool GateIngest::apply(const GateEvent& event) {
+    bool success = false;
+    if (event.type == GATE_CREATE) {
+        int requestId = system->createRequest(event.vehicleId, event.zoneId);
+        success = system->processRequest(requestId);
+    } else {
+        ParkingRequest* request = system->findRequestByVehicle(event.vehicleId);
+        if (request != nullptr) {
+            int requestId = request->getRequestId();
+            switch (event.type) {
+                case GATE_ARRIVE: success = system->markVehicleArrived(requestId); break;
+                case GATE_EXIT: success = system->markVehicleExited(requestId); break;
+                case GATE_CANCEL: success = system->cancelRequest(requestId); break;
+                default: break;
+            }
+        }
+    }
+
+    appliedCount++;
+    if (!success) {
+        failedCount++;
+    }
+    return success;
+}
+
+bool GateIngest::post(GateEventType type, const char* vehicleId, int zoneId) {
+    if (vehicleId == nullptr || strlen(vehicleId) >= GateEvent::PLATE_BYTES) {
+        rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    GateEvent event;
+    event.type = type;
+    event.zoneId = zoneId;
+    strcpy(event.vehicleId, vehicleId);
+
+    if (!ring.tryPush(event)) {
+        rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    postedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool GateIngest::postCreate(const char* vehicleId, int zoneId) {
+    return post(GATE_CREATE, vehicleId, zoneId);
+}
+
+bool GateIngest::postArrive(const char* vehicleId) {
+    return post(GATE_ARRIVE, vehicleId, 0);
+}
+
+bool GateIngest::postExit(const char* vehicleId) {
+    return post(GATE_EXIT, vehicleId, 0);
+}
+
+bool GateIngest::postCancel(const char* vehicleId) {
+    return post(GATE_CANCEL, vehicleId, 0);
+}
+
+long long GateIngest::getPostedCount() const {
+    return postedCount.load();
+}
+
+long long GateIngest::getRejectedCount() const {
+    return rejectedCount.load();
+}
+
+long long GateIngest::getAppliedCount() const {
+    return appliedCount;
+}
+
+long long GateIngest::getFailedCount() const {
+    return failedCount;
+}
+
+int GateIngest::getBacklog() const {
+    return ring.getSizeApprox();
+}
+
+int GateIngest::getCapacity() const {
+    return ring.getCapacity();
+}
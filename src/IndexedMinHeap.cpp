@@ -0,0 +1,141 @@
+#include "include/IndexedMinHeap.h"
+
+IndexedMinHeap::IndexedMinHeap(int initialCapacity)
+    : entries(initialCapacity), positions(initialCapacity) {}
+
+void IndexedMinHeap::place(int index, const HeapEntry& entry) {
+    entries[index] = entry;
+    positions[entry.id] = index;
+}
+
+void IndexedMinHeap::siftUp(int index) {
+    HeapEntry entry = entries[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (entries[parent].key <= entry.key) break;
+        place(index, entries[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void IndexedMinHeap::siftDown(int index) {
+    int size = entries.getSize();
+    HeapEntry entry = entries[index];
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) break;
+        if (child + 1 < size && entries[child + 1].key < entries[child].key) {
+            child++;
+        }
+        if (entry.key <= entries[child].key) break;
+        place(index, entries[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+bool IndexedMinHeap::push(int id, long long key) {
+    if (id < 0) return false;
+    while (positions.getSize() <= id) {
+        positions.add(-1);
+    }
+
+    int index = positions[id];
+    if (index != -1) {
+        // Re-key in place
+        long long oldKey = entries[index].key;
+        entries[index].key = key;
+        if (key < oldKey) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+        return true;
+    }
+
+    HeapEntry entry;
+    entry.key = key;
+    entry.id = id;
+    entries.add(entry);
+    positions[id] = entries.getSize() - 1;
+    siftUp(entries.getSize() - 1);
+    return true;
+}
+
+bool IndexedMinHeap::remove(int id) {
+    if (!contains(id)) return false;
+
+    int index = positions[id];
+    int last = entries.getSize() - 1;
+    positions[id] = -1;
+    if (index != last) {
+        // Move the last entry into the hole, then restore order in whichever direction it violates
+        HeapEntry moved = entries[last];
+        entries.remove(last);
+        place(index, moved);
+        siftUp(index);
+        siftDown(positions[moved.id]);
+    } else {
+        entries.remove(last);
+    }
+    return true;
+}
+
+bool IndexedMinHeap::contains(int id) const {
+    return id >= 0 && id < positions.getSize() && positions[id] != -1;
+}
+
+long long IndexedMinHeap::getKey(int id) const {
+    if (!contains(id)) return -1;
+    return entries[positions[id]].key;
+}
+
+bool IndexedMinHeap::isEmpty() const {
+    return entries.isEmpty();
+}
+
+int IndexedMinHeap::getSize() const {
+    return entries.getSize();
+}
+
+int IndexedMinHeap::topId() const {
+    if (entries.isEmpty()) return -1;
+    return entries[0].id;
+}
+
+long long IndexedMinHeap::topKey() const {
+    if (entries.isEmpty()) return -1;
+    return entries[0].key;
+}
+
+int IndexedMinHeap::pop() {
+    int id = topId();
+    if (id != -1) {
+        remove(id);
+    }
+    return id;
+}
+
+int IndexedMinHeap::collectAtMost(long long limit, DynamicArray<int>& ids) const {
+    if (entries.isEmpty() || entries[0].key > limit) return 0;
+
+    // Heap order means a subtree whose root is past the limit can be skipped whole
+    int found = 0;
+    DynamicArray<int> stack;
+    stack.add(0);
+    while (!stack.isEmpty()) {
+        int index = stack[stack.getSize() - 1];
+        stack.remove(stack.getSize() - 1);
+        ids.add(entries[index].id);
+        found++;
+
+        int child = 2 * index + 1;
+        for (int c = child; c <= child + 1 && c < entries.getSize(); c++) {
+            if (entries[c].key <= limit) {
+                stack.add(c);
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,111 @@
+#include "include/MinCostFlow.h"
+#include <climits>
+
+MinCostFlow::MinCostFlow(int nodes)
+    : nodeCount(nodes < 1 ? 1 : nodes), edgeTo(16), edgeCapacity(16), edgeCost(16),
+      edgeNext(16), augmentCount(0) {
+    head = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        head[i] = -1;
+    }
+}
+
+MinCostFlow::~MinCostFlow() {
+    delete[] head;
+}
+
+int MinCostFlow::addEdge(int from, int to, int capacity, long long cost) {
+    if (from < 0 || from >= nodeCount || to < 0 || to >= nodeCount) return -1;
+
+    int forward = edgeTo.getSize();
+    edgeTo.add(to);
+    edgeCapacity.add(capacity);
+    edgeCost.add(cost);
+    edgeNext.add(head[from]);
+    head[from] = forward;
+
+    edgeTo.add(from);
+    edgeCapacity.add(0);
+    edgeCost.add(-cost);
+    edgeNext.add(head[to]);
+    head[to] = forward + 1;
+    return forward;
+}
+
+int MinCostFlow::solve(int source, int sink, long long& totalCost) {
+    totalCost = 0;
+    int totalFlow = 0;
+    if (source == sink) return 0;
+
+    long long* dist = new long long[nodeCount];
+    int* parentEdge = new int[nodeCount];
+    bool* inQueue = new bool[nodeCount];
+    int* queue = new int[nodeCount];     // Circular SPFA queue (each node queued at most once)
+
+    while (true) {
+        // Cheapest augmenting path in the residual graph
+        for (int i = 0; i < nodeCount; i++) {
+            dist[i] = LLONG_MAX;    // Unreached (residual costs can be negative)
+            parentEdge[i] = -1;
+            inQueue[i] = false;
+        }
+        dist[source] = 0;
+        int front = 0;
+        int size = 0;
+        queue[(front + size++) % nodeCount] = source;
+        inQueue[source] = true;
+
+        while (size > 0) {
+            int u = queue[front];
+            front = (front + 1) % nodeCount;
+            size--;
+            inQueue[u] = false;
+
+            for (int e = head[u]; e >= 0; e = edgeNext[e]) {
+                if (edgeCapacity[e] <= 0) continue;
+                int v = edgeTo[e];
+                long long candidate = dist[u] + edgeCost[e];
+                if (candidate < dist[v]) {
+                    dist[v] = candidate;
+                    parentEdge[v] = e;
+                    if (!inQueue[v]) {
+                        queue[(front + size++) % nodeCount] = v;
+                        inQueue[v] = true;
+                    }
+                }
+            }
+        }
+
+        if (parentEdge[sink] < 0) break;
+
+        // Bottleneck along the path, then push
+        int push = -1;
+        for (int v = sink; v != source; v = edgeTo[parentEdge[v] ^ 1]) {
+            int capacity = edgeCapacity[parentEdge[v]];
+            if (push < 0 || capacity < push) push = capacity;
+        }
+        for (int v = sink; v != source; v = edgeTo[parentEdge[v] ^ 1]) {
+            edgeCapacity[parentEdge[v]] -= push;
+            edgeCapacity[parentEdge[v] ^ 1] += push;
+        }
+
+        totalFlow += push;
+        totalCost += push * dist[sink];
+        augmentCount++;
+    }
+
+    delete[] dist;
+    delete[] parentEdge;
+    delete[] inQueue;
+    delete[] queue;
+    return totalFlow;
+}
+
+int MinCostFlow::getFlow(int edge) const {
+    if (edge < 0 || edge + 1 >= edgeCapacity.getSize()) return 0;
+    return edgeCapacity[edge ^ 1];
+}
+
+int MinCostFlow::getAugmentCount() const {
+    return augmentCount;
+}
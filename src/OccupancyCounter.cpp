@@ -0,0 +1,90 @@
+#include "include/OccupancyCounter.h"
+
+OccupancyCounter::OccupancyCounter() : parent(nullptr) {
+    for (int i = 0; i < STATUS_COUNT; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void OccupancyCounter::apply(const SlotStatusCounts& delta, int sign) {
+    for (OccupancyCounter* level = this; level != nullptr; level = level->parent) {
+        for (int i = 0; i < STATUS_COUNT; i++) {
+            int change = sign * delta.get((SlotStatus)i);
+            if (change != 0) {
+                level->counts[i].fetch_add(change, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void OccupancyCounter::attachTo(OccupancyCounter* parentCounter) {
+    if (parent == parentCounter) return;
+
+    // Move this level's totals from the old ancestors to the new ones
+    SlotStatusCounts current = getCounts();
+    if (parent != nullptr) {
+        parent->apply(current, -1);
+    }
+    parent = parentCounter;
+    if (parent != nullptr) {
+        parent->apply(current, 1);
+    }
+}
+
+void OccupancyCounter::addSlots(int count, SlotStatus status) {
+    SlotStatusCounts delta;
+    delta.adjust(status, count);
+    apply(delta, 1);
+}
+
+void OccupancyCounter::transition(SlotStatus from, SlotStatus to) {
+    if (from == to) return;
+    for (OccupancyCounter* level = this; level != nullptr; level = level->parent) {
+        level->counts[from].fetch_sub(1, std::memory_order_relaxed);
+        level->counts[to].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void OccupancyCounter::resync(const SlotStatusCounts& actual) {
+    SlotStatusCounts current = getCounts();
+    SlotStatusCounts delta;
+    delta.available = actual.available - current.available;
+    delta.occupied = actual.occupied - current.occupied;
+    delta.reserved = actual.reserved - current.reserved;
+    delta.maintenance = actual.maintenance - current.maintenance;
+    apply(delta, 1);
+}
+
+int OccupancyCounter::getTotalSlots() const {
+    return getCounts().total();
+}
+
+int OccupancyCounter::getCount(SlotStatus status) const {
+    if (status < 0 || status >= STATUS_COUNT) return 0;
+    return counts[status].load(std::memory_order_relaxed);
+}
+
+int OccupancyCounter::getAvailableSlots() const {
+    return counts[SLOT_AVAILABLE].load(std::memory_order_relaxed);
+}
+
+int OccupancyCounter::getUnavailableSlots() const {
+    SlotStatusCounts current = getCounts();
+    return current.total() - current.available;
+}
+
+float OccupancyCounter::getUtilization() const {
+    SlotStatusCounts current = getCounts();
+    int total = current.total();
+    if (total == 0) return 0.0f;
+    return (float)(total - current.available) / total;
+}
+
+SlotStatusCounts OccupancyCounter::getCounts() const {
+    SlotStatusCounts snapshot;
+    snapshot.available = counts[SLOT_AVAILABLE].load(std::memory_order_relaxed);
+    snapshot.occupied = counts[SLOT_OCCUPIED].load(std::memory_order_relaxed);
+    snapshot.reserved = counts[SLOT_RESERVED].load(std::memory_order_relaxed);
+    snapshot.maintenance = counts[SLOT_MAINTENANCE].load(std::memory_order_relaxed);
+    return snapshot;
+}
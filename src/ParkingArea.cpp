@@ -1,29 +1,28 @@
 #include "include/ParkingArea.h"
+#include "include/Zone.h"
 #include <iostream>
 #include <cstring>
 
 ParkingArea::ParkingArea(int id, int zone, const char* name, int slotCount) 
-    : areaId(id), zoneId(zone), totalSlots(slotCount), occupiedSlots(0) {
+    : areaId(id), zoneId(zone), totalSlots(slotCount),
+      firstSlotId(id * getSlotIdStride(slotCount)),
+      slotTable(this, id, zone, slotCount, id * getSlotIdStride(slotCount)),
+      freeSlots(slotCount, true), searchMode(SEARCH_BITMAP), 
+      ownerZone(nullptr), areaIndex(-1), nextFitCursor(0) {
     
     // Copy area name
     int len = strlen(name);
     areaName = new char[len + 1];
     strcpy(areaName, name);
     
-    // Create slots array
-    slots = new ParkingSlot*[totalSlots];
-    for (int i = 0; i < totalSlots; i++) {
-        int slotId = areaId * 1000 + i;  // Unique slot ID
-        slots[i] = new ParkingSlot(slotId, areaId, zoneId);
+    for (int b = 0; b < SLOT_ATTRIBUTE_COUNT; b++) {
+        attributeSlots[b].resize(slotCount);
     }
+    occupancy.addSlots(slotTable.getSlotCount());
 }
 
 ParkingArea::~ParkingArea() {
     delete[] areaName;
-    for (int i = 0; i < totalSlots; i++) {
-        delete slots[i];
-    }
-    delete[] slots;
 }
 
 int ParkingArea::getAreaId() const {
@@ -43,65 +42,321 @@ int ParkingArea::getTotalSlots() const {
 }
 
 int ParkingArea::getOccupiedSlots() const {
-    return occupiedSlots;
+    return occupancy.getUnavailableSlots();
 }
 
 int ParkingArea::getAvailableSlots() const {
-    return totalSlots - occupiedSlots;
+    return occupancy.getAvailableSlots();
 }
 
 float ParkingArea::getUtilization() const {
-    if (totalSlots == 0) return 0.0f;
-    return (float)occupiedSlots / totalSlots;
+    return occupancy.getUtilization();
+}
+
+bool ParkingArea::hasAvailableSlot() const {
+    return !freeSlots.none();
+}
+
+OccupancyCounter* ParkingArea::getOccupancy() {
+    return &occupancy;
 }
 
 ParkingSlot* ParkingArea::findFirstAvailableSlot() {
+    if (searchMode == SEARCH_LINEAR) {
+        return findFirstAvailableSlotLinear();
+    }
+    if (searchMode == SEARCH_SIMD) {
+        return findFirstAvailableSlotSimd();
+    }
+    return findFirstAvailableSlotBitmap();
+}
+
+ParkingSlot* ParkingArea::findFirstAvailableSlotLinear() {
     for (int i = 0; i < totalSlots; i++) {
-        if (slots[i]->isAvailable()) {
-            return slots[i];
+        ParkingSlot* slot = slotTable.getView(i);
+        if (slot->isAvailable()) {
+            return slot;
         }
     }
     return nullptr;
 }
 
+ParkingSlot* ParkingArea::findFirstAvailableSlotBitmap() {
+    int index = freeSlots.findFirstSet();
+    if (index < 0) {
+        return nullptr;
+    }
+    return slotTable.getView(index);
+}
+
+ParkingSlot* ParkingArea::findFirstAvailableSlotSimd() {
+    return slotTable.getView(slotTable.findFirstAvailable());
+}
+
+ParkingSlot* ParkingArea::findFirstAvailableSlotWith(unsigned int required) {
+    if (required == 0) {
+        return findFirstAvailableSlot();
+    }
+    return slotTable.getView(findNextAvailableIndex(0, required));
+}
+
+ParkingSlot* ParkingArea::findNextAvailableSlotWith(int fromIndex, unsigned int required) {
+    return slotTable.getView(findNextAvailableIndex(fromIndex, required));
+}
+
+void ParkingArea::resolveScanWords(unsigned int required, ScanWords& scan) const {
+    // A constrained scan then reads one more word per required attribute per
+    // 64 slots, with no call or bounds check per word
+    scan.free = freeSlots.getWords();
+    scan.attributeCount = 0;
+    for (int b = 0; b < SLOT_ATTRIBUTE_COUNT; b++) {
+        if (required & (1u << b)) {
+            scan.attributes[scan.attributeCount++] = attributeSlots[b].getWords();
+        }
+    }
+}
+
+int ParkingArea::findNextAvailableIndex(int fromIndex, unsigned int required) const {
+    if (required == 0) {
+        return freeSlots.findNextSet(fromIndex);
+    }
+    if (fromIndex < 0) fromIndex = 0;
+    if (fromIndex >= totalSlots || !offersAttributes(required)) return -1;
+    
+    // Hottest constrained loop: the AND is written out so no call is made per word,
+    // and a word with no free slot skips its attribute reads
+    ScanWords scan;
+    resolveScanWords(required, scan);
+    const unsigned long long* free = scan.free;
+    int wordCount = freeSlots.getWordCount();
+    unsigned long long firstMask = ~0ULL << (fromIndex & 63);
+    for (int w = fromIndex >> 6; w < wordCount; w++) {
+        unsigned long long word = free[w] & firstMask;
+        firstMask = ~0ULL;
+        for (int a = 0; a < scan.attributeCount && word != 0; a++) {
+            word &= scan.attributes[a][w];
+        }
+        if (word != 0) {
+            return (w << 6) + Bitmap::countTrailingZeros(word);
+        }
+    }
+    return -1;
+}
+
+int ParkingArea::findFreeRun(int length, unsigned int required) const {
+    if (length <= 0 || occupancy.getAvailableSlots() < length) return -1;
+    if (required != 0 && !offersAttributes(required)) return -1;
+    
+    // One pass over the words. A run may start in the high bits of one word
+    // and continue through full words into the low bits of a later one, so the
+    // free bits at the top of each word are carried forward as `run`.
+    ScanWords scan;
+    resolveScanWords(required, scan);
+    int run = 0;
+    int runStart = 0;
+    int wordCount = freeSlots.getWordCount();
+    for (int w = 0; w < wordCount; w++) {
+        unsigned long long word = scan.at(w);
+        if (word == ~0ULL) {
+            if (run == 0) runStart = w << 6;
+            run += 64;
+            if (run >= length) return runStart;
+            continue;
+        }
+        
+        // Carried run continues through this word's low free bits
+        if (run > 0 && run + Bitmap::countTrailingZeros(~word) >= length) {
+            return runStart;
+        }
+        
+        // Runs inside the word: after shift-ANDs covering length - 1 bits, bit i
+        // survives only if bits i .. i + length - 1 are all free. Shifts double,
+        // so this is O(log length) per word however fragmented the area is.
+        if (length <= 64) {
+            unsigned long long starts = word;
+            int covered = 1;
+            while (covered < length && starts != 0) {
+                int shift = covered < length - covered ? covered : length - covered;
+                starts &= starts >> shift;
+                covered += shift;
+            }
+            if (starts != 0) {
+                return (w << 6) + Bitmap::countTrailingZeros(starts);
+            }
+        }
+        
+        run = Bitmap::countLeadingZeros(~word);
+        runStart = ((w + 1) << 6) - run;
+    }
+    return -1;
+}
+
+ParkingSlot* ParkingArea::findFirstInServiceSlot() {
+    return slotTable.getView(slotTable.findFirstNotMaintenance());
+}
+
+int ParkingArea::collectAvailableSlots(ParkingSlot** out, int maxCount, unsigned int required) {
+    int found = 0;
+    for (int index = findNextAvailableIndex(0, required); index >= 0 && found < maxCount;
+         index = findNextAvailableIndex(index + 1, required)) {
+        out[found++] = slotTable.getView(index);
+    }
+    return found;
+}
+
+int ParkingArea::countAvailableSlots(unsigned int required) const {
+    if (required == 0) return occupancy.getAvailableSlots();
+    if (!offersAttributes(required)) return 0;
+    
+    ScanWords scan;
+    resolveScanWords(required, scan);
+    int count = 0;
+    int wordCount = freeSlots.getWordCount();
+    for (int w = 0; w < wordCount; w++) {
+        count += Bitmap::popCount(scan.at(w));
+    }
+    return count;
+}
+
 ParkingSlot* ParkingArea::getSlotById(int slotId) {
+    ParkingSlot* slot = getSlotByIndex(slotId - firstSlotId);
+    if (slot != nullptr && slot->getSlotId() == slotId) {
+        return slot;
+    }
+    
+    // Slot may have been re-keyed by the SlotDirectory after an ID clash
     for (int i = 0; i < totalSlots; i++) {
-        if (slots[i]->getSlotId() == slotId) {
-            return slots[i];
+        if (slotTable.getSlotId(i) == slotId) {
+            return slotTable.getView(i);
         }
     }
     return nullptr;
 }
 
+ParkingSlot* ParkingArea::getSlotByIndex(int index) {
+    return slotTable.getView(index);
+}
+
+SlotTable* ParkingArea::getSlotTable() {
+    return &slotTable;
+}
+
+int ParkingArea::getSlotIdStride(int slotCount) {
+    // Keep the familiar areaId * 1000 + i IDs; widen for areas with more slots
+    int stride = 1000;
+    while (stride < slotCount) {
+        stride *= 10;
+    }
+    return stride;
+}
+
 bool ParkingArea::allocateSlot(int slotId, const char* vehicleId) {
     ParkingSlot* slot = getSlotById(slotId);
     if (slot == nullptr) return false;
     
-    if (slot->allocate(vehicleId)) {
-        occupiedSlots++;
-        return true;
-    }
-    return false;
+    return slot->allocate(vehicleId);
 }
 
 bool ParkingArea::releaseSlot(int slotId) {
     ParkingSlot* slot = getSlotById(slotId);
     if (slot == nullptr) return false;
     
-    if (slot->release()) {
-        occupiedSlots--;
-        return true;
+    return slot->release();
+}
+
+bool ParkingArea::allocateRun(int firstIndex, int length, VehicleHandle vehicle) {
+    if (firstIndex < 0 || length <= 0 || firstIndex + length > totalSlots) return false;
+    for (int i = firstIndex; i < firstIndex + length; i++) {
+        if (!freeSlots.test(i)) return false;
+    }
+    for (int i = firstIndex; i < firstIndex + length; i++) {
+        slotTable.getView(i)->allocate(vehicle);
     }
-    return false;
+    return true;
 }
 
-void ParkingArea::updateOccupancyCount() {
-    occupiedSlots = 0;
-    for (int i = 0; i < totalSlots; i++) {
-        if (!slots[i]->isAvailable()) {
-            occupiedSlots++;
+bool ParkingArea::releaseRun(int firstIndex, int length) {
+    if (firstIndex < 0 || length <= 0 || firstIndex + length > totalSlots) return false;
+    for (int i = firstIndex; i < firstIndex + length; i++) {
+        if (slotTable.getStatus(i) != SLOT_OCCUPIED) return false;
+    }
+    for (int i = firstIndex; i < firstIndex + length; i++) {
+        slotTable.getView(i)->release();
+    }
+    return true;
+}
+
+bool ParkingArea::transitionSlot(int slotIndex, SlotStatus newStatus) {
+    if (slotIndex < 0 || slotIndex >= totalSlots) return false;
+    
+    SlotStatus oldStatus = slotTable.getStatus(slotIndex);
+    if (oldStatus == newStatus) return true;
+    
+    bool hadCapacity = hasAvailableSlot();
+    slotTable.setStatus(slotIndex, newStatus);
+    freeSlots.assign(slotIndex, newStatus == SLOT_AVAILABLE);
+    occupancy.transition(oldStatus, newStatus);
+    
+    bool hasCapacity = hasAvailableSlot();
+    if (ownerZone != nullptr && hadCapacity != hasCapacity) {
+        ownerZone->onAreaCapacityChanged(areaIndex, hasCapacity);
+    }
+    if (ownerZone != nullptr && newStatus == SLOT_AVAILABLE) {
+        ownerZone->invalidateMisses();
+    }
+    return true;
+}
+
+void ParkingArea::setSlotAttributes(int slotIndex, unsigned int mask) {
+    if (slotIndex < 0 || slotIndex >= totalSlots) return;
+    
+    slotTable.setAttributes(slotIndex, mask);
+    for (int b = 0; b < SLOT_ATTRIBUTE_COUNT; b++) {
+        attributeSlots[b].assign(slotIndex, (mask & (1u << b)) != 0);
+    }
+    if (ownerZone != nullptr) {
+        ownerZone->invalidateMisses();
+    }
+}
+
+bool ParkingArea::offersAttributes(unsigned int required) const {
+    if (required >> SLOT_ATTRIBUTE_COUNT) return false;    // Unknown attribute
+    for (int b = 0; b < SLOT_ATTRIBUTE_COUNT; b++) {
+        if ((required & (1u << b)) && attributeSlots[b].none()) {
+            return false;
         }
     }
+    return true;
+}
+
+void ParkingArea::setSearchMode(SlotSearchMode mode) {
+    searchMode = mode;
+}
+
+SlotSearchMode ParkingArea::getSearchMode() const {
+    return searchMode;
+}
+
+int ParkingArea::getNextFitCursor() const {
+    return nextFitCursor;
+}
+
+void ParkingArea::setNextFitCursor(int index) {
+    nextFitCursor = (index >= 0 && index < totalSlots) ? index : 0;
+}
+
+void ParkingArea::attachToZone(Zone* zone, int index) {
+    ownerZone = zone;
+    areaIndex = index;
+}
+
+void ParkingArea::updateOccupancyCount() {
+    // Recount from the status column and push any correction up the hierarchy
+    occupancy.resync(slotTable.getStatusCounts());
+}
+
+SlotStatusCounts ParkingArea::getStatusCounts(KernelLevel level) const {
+    return slotTable.getStatusCounts(level);
 }
 
 void ParkingArea::displayAreaInfo() const {
@@ -109,7 +364,7 @@ void ParkingArea::displayAreaInfo() const {
               << " (ID: " << areaId << ")"
               << ", Zone: " << zoneId
               << ", Total Slots: " << totalSlots
-              << ", Occupied: " << occupiedSlots
+              << ", Occupied: " << getOccupiedSlots()
               << ", Available: " << getAvailableSlots()
               << ", Utilization: " << (getUtilization() * 100) << "%"
               << std::endl;
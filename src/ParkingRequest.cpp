@@ -1,22 +1,41 @@
 #include "include/ParkingRequest.h"
 #include <iostream>
-#include <cstring>
 #include <ctime>
 
-ParkingRequest::ParkingRequest(int id, const char* vehicle, int zone) 
-    : requestId(id), requestedZoneId(zone), allocatedSlotId(-1), 
-      currentState(REQUESTED), allocationTime(0), occupiedTime(0), 
-      releaseTime(0), crossZoneAllocation(false) {
-    
-    int len = strlen(vehicle);
-    vehicleId = new char[len + 1];
-    strcpy(vehicleId, vehicle);
-    
+ParkingRequest::ParkingRequest(int id, VehicleHandle vehicleHandle, int zone,
+                               const VehicleIdPool* pool) 
+    : requestId(id), vehicle(vehicleHandle), vehiclePool(pool), requestedZoneId(zone), allocatedSlotId(-1), 
+      allocatedSlotHandle(-1), currentState(REQUESTED), allocationTime(0), occupiedTime(0), 
+      releaseTime(0), crossZoneAllocation(false), queued(false), expiryTimer(NO_TIMER),
+      bookedDuration(0), overstayFlagged(false), priority(0), waitlisted(false),
+      requestClass(CLASS_STANDARD), classCharged(false), requiredAttributes(0), slotCount(1) {
     requestTime = time(nullptr);
 }
 
-ParkingRequest::~ParkingRequest() {
-    delete[] vehicleId;
+ParkingRequest::~ParkingRequest() {}
+
+void ParkingRequest::reset(int id, VehicleHandle vehicleHandle, int zone) {
+    requestId = id;
+    vehicle = vehicleHandle;
+    requestedZoneId = zone;
+    allocatedSlotId = -1;
+    allocatedSlotHandle = -1;
+    currentState = REQUESTED;
+    allocationTime = 0;
+    occupiedTime = 0;
+    releaseTime = 0;
+    crossZoneAllocation = false;
+    queued = false;
+    expiryTimer = NO_TIMER;
+    bookedDuration = 0;
+    overstayFlagged = false;
+    priority = 0;
+    waitlisted = false;
+    requestClass = CLASS_STANDARD;
+    classCharged = false;
+    requiredAttributes = 0;
+    slotCount = 1;
+    requestTime = time(nullptr);
 }
 
 int ParkingRequest::getRequestId() const {
@@ -24,7 +43,11 @@ int ParkingRequest::getRequestId() const {
 }
 
 const char* ParkingRequest::getVehicleId() const {
-    return vehicleId;
+    return vehiclePool->getString(vehicle);
+}
+
+VehicleHandle ParkingRequest::getVehicleHandle() const {
+    return vehicle;
 }
 
 int ParkingRequest::getRequestedZoneId() const {
@@ -35,6 +58,10 @@ int ParkingRequest::getAllocatedSlotId() const {
     return allocatedSlotId;
 }
 
+int ParkingRequest::getAllocatedSlotHandle() const {
+    return allocatedSlotHandle;
+}
+
 RequestState ParkingRequest::getState() const {
     return currentState;
 }
@@ -59,6 +86,94 @@ bool ParkingRequest::isCrossZone() const {
     return crossZoneAllocation;
 }
 
+bool ParkingRequest::isQueued() const {
+    return queued;
+}
+
+void ParkingRequest::setQueued(bool value) {
+    queued = value;
+}
+
+TimerHandle ParkingRequest::getExpiryTimer() const {
+    return expiryTimer;
+}
+
+void ParkingRequest::setExpiryTimer(TimerHandle handle) {
+    expiryTimer = handle;
+}
+
+long long ParkingRequest::getBookedDuration() const {
+    return bookedDuration;
+}
+
+void ParkingRequest::setBookedDuration(long long seconds) {
+    bookedDuration = seconds < 0 ? 0 : seconds;
+}
+
+bool ParkingRequest::isOverstayFlagged() const {
+    return overstayFlagged;
+}
+
+void ParkingRequest::setOverstayFlagged(bool value) {
+    overstayFlagged = value;
+}
+
+int ParkingRequest::getPriority() const {
+    return priority;
+}
+
+void ParkingRequest::setPriority(int value) {
+    if (value < 0) value = 0;
+    if (value > MAX_REQUEST_PRIORITY) value = MAX_REQUEST_PRIORITY;
+    priority = value;
+}
+
+bool ParkingRequest::isWaitlisted() const {
+    return waitlisted;
+}
+
+void ParkingRequest::setWaitlisted(bool value) {
+    waitlisted = value;
+}
+
+RequestClass ParkingRequest::getRequestClass() const {
+    return requestClass;
+}
+
+void ParkingRequest::setRequestClass(RequestClass value) {
+    requestClass = value;
+    
+    // Classes spread evenly over the waitlist priority range
+    int classPriority = value * MAX_REQUEST_PRIORITY / (REQUEST_CLASS_COUNT - 1);
+    if (priority < classPriority) {
+        priority = classPriority;
+    }
+}
+
+bool ParkingRequest::isClassCharged() const {
+    return classCharged;
+}
+
+void ParkingRequest::setClassCharged(bool value) {
+    classCharged = value;
+}
+
+unsigned int ParkingRequest::getRequiredAttributes() const {
+    return requiredAttributes;
+}
+
+void ParkingRequest::setRequiredAttributes(unsigned int mask) {
+    requiredAttributes = mask;
+}
+
+int ParkingRequest::getSlotCount() const {
+    return slotCount;
+}
+
+void ParkingRequest::setSlotCount(int count) {
+    slotCount = count < 1 ? 1 : count;
+}
+
 bool ParkingRequest::setState(RequestState newState) {
     if (!StateValidator::isValidTransition(currentState, newState)) {
         std::cout << "Invalid transition: " 
@@ -70,17 +185,33 @@ bool ParkingRequest::setState(RequestState newState) {
     return true;
 }
 
-bool ParkingRequest::allocateSlot(int slotId, bool isCrossZone) {
+bool ParkingRequest::allocateSlot(int slotId, bool isCrossZone, int slotHandle) {
     if (!setState(ALLOCATED)) {
         return false;
     }
     
     allocatedSlotId = slotId;
+    allocatedSlotHandle = slotHandle;
     crossZoneAllocation = isCrossZone;
     allocationTime = time(nullptr);
     return true;
 }
 
+bool ParkingRequest::revertAllocation() {
+    // Not a lifecycle transition (the validator has no edge back to
+    // REQUESTED); only rollback undoes an allocation
+    if (currentState != ALLOCATED) {
+        return false;
+    }
+    
+    currentState = REQUESTED;
+    allocatedSlotId = -1;
+    allocatedSlotHandle = -1;
+    crossZoneAllocation = false;
+    allocationTime = 0;
+    return true;
+}
+
 bool ParkingRequest::markOccupied() {
     if (!setState(OCCUPIED)) {
         return false;
@@ -115,7 +246,7 @@ long long ParkingRequest::getParkingDuration() const {
 
 void ParkingRequest::displayRequestInfo() const {
     std::cout << "Request ID: " << requestId 
-              << ", Vehicle: " << vehicleId
+              << ", Vehicle: " << getVehicleId()
               << ", Requested Zone: " << requestedZoneId
               << ", State: " << getStateString();
     
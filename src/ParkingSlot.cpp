@@ -1,90 +1,130 @@
 #include "include/ParkingSlot.h"
+#include "include/SlotTable.h"
+#include "include/ParkingArea.h"
 #include <iostream>
-#include <cstring>
 
-ParkingSlot::ParkingSlot(int id, int area, int zone) 
-    : slotId(id), areaId(area), zoneId(zone), status(SLOT_AVAILABLE), 
-      allocatedVehicleId(nullptr), allocationTime(0) {}
+ParkingSlot::ParkingSlot(SlotTable* owner, int index) 
+    : table(owner), slotIndex(index) {}
 
-ParkingSlot::~ParkingSlot() {
-    if (allocatedVehicleId != nullptr) {
-        delete[] allocatedVehicleId;
-    }
-}
+ParkingSlot::~ParkingSlot() {}
 
 int ParkingSlot::getSlotId() const {
-    return slotId;
+    return table->getSlotId(slotIndex);
 }
 
 int ParkingSlot::getAreaId() const {
-    return areaId;
+    return table->getAreaId();
 }
 
 int ParkingSlot::getZoneId() const {
-    return zoneId;
+    return table->getZoneId();
 }
 
 SlotStatus ParkingSlot::getStatus() const {
-    return status;
+    return table->getStatus(slotIndex);
 }
 
 const char* ParkingSlot::getAllocatedVehicleId() const {
-    return allocatedVehicleId;
+    return table->getVehicleId(slotIndex);
+}
+
+VehicleHandle ParkingSlot::getAllocatedVehicleHandle() const {
+    return table->getVehicleHandle(slotIndex);
 }
 
 bool ParkingSlot::isAvailable() const {
-    return status == SLOT_AVAILABLE;
+    return table->getStatus(slotIndex) == SLOT_AVAILABLE;
+}
+
+unsigned int ParkingSlot::getAttributes() const {
+    return table->getAttributes(slotIndex);
+}
+
+bool ParkingSlot::hasAttributes(unsigned int required) const {
+    return (table->getAttributes(slotIndex) & required) == required;
 }
 
 long long ParkingSlot::getAllocationTime() const {
-    return allocationTime;
+    return table->getAllocationTime(slotIndex);
 }
 
-bool ParkingSlot::allocate(const char* vehicleId) {
+int ParkingSlot::getSlotIndex() const {
+    return slotIndex;
+}
+
+void ParkingSlot::setSlotId(int id) {
+    table->setSlotId(slotIndex, id);
+}
+
+int ParkingSlot::getSlotHandle() const {
+    return table->getSlotHandle(slotIndex);
+}
+
+ParkingArea* ParkingSlot::getArea() const {
+    return table->getOwnerArea();
+}
+
+void ParkingSlot::setSlotHandle(int handle) {
+    table->setSlotHandle(slotIndex, handle);
+}
+
+bool ParkingSlot::transitionTo(SlotStatus newStatus) {
+    ParkingArea* ownerArea = table->getOwnerArea();
+    if (ownerArea == nullptr) {
+        table->setStatus(slotIndex, newStatus);
+        return true;
+    }
+    return ownerArea->transitionSlot(slotIndex, newStatus);
+}
+
+bool ParkingSlot::allocate(VehicleHandle vehicle) {
     if (!isAvailable()) {
         return false;
     }
     
-    // Copy vehicle ID
-    if (vehicleId != nullptr) {
-        int len = strlen(vehicleId);
-        allocatedVehicleId = new char[len + 1];
-        strcpy(allocatedVehicleId, vehicleId);
-    }
-    
-    status = SLOT_OCCUPIED;
-    allocationTime = time(nullptr);
-    return true;
+    table->setVehicleHandle(slotIndex, vehicle);
+    table->setAllocationTime(slotIndex, time(nullptr));
+    return transitionTo(SLOT_OCCUPIED);
+}
+
+bool ParkingSlot::allocate(const char* vehicleId) {
+    // Plates are only recorded once the area is registered with a system pool
+    VehicleIdPool* pool = table->getVehiclePool();
+    return allocate(pool != nullptr ? pool->intern(vehicleId) : NO_VEHICLE);
 }
 
 bool ParkingSlot::release() {
-    if (status != SLOT_OCCUPIED) {
+    if (table->getStatus(slotIndex) != SLOT_OCCUPIED) {
         return false;
     }
     
-    if (allocatedVehicleId != nullptr) {
-        delete[] allocatedVehicleId;
-        allocatedVehicleId = nullptr;
-    }
-    
-    status = SLOT_AVAILABLE;
-    allocationTime = 0;
-    return true;
+    table->setVehicleHandle(slotIndex, NO_VEHICLE);
+    table->setAllocationTime(slotIndex, 0);
+    return transitionTo(SLOT_AVAILABLE);
 }
 
 bool ParkingSlot::setStatus(SlotStatus newStatus) {
-    status = newStatus;
-    return true;
+    return transitionTo(newStatus);
+}
+
+void ParkingSlot::setAttributes(unsigned int mask) {
+    ParkingArea* ownerArea = table->getOwnerArea();
+    if (ownerArea == nullptr) {
+        table->setAttributes(slotIndex, mask);
+        return;
+    }
+    ownerArea->setSlotAttributes(slotIndex, mask);
 }
 
 void ParkingSlot::displayInfo() const {
-    std::cout << "Slot ID: " << slotId 
-              << ", Zone: " << zoneId 
-              << ", Area: " << areaId 
+    std::cout << "Slot ID: " << getSlotId() 
+              << ", Zone: " << getZoneId() 
+              << ", Area: " << getAreaId() 
               << ", Status: " << (isAvailable() ? "AVAILABLE" : "OCCUPIED");
     
-    if (allocatedVehicleId != nullptr) {
-        std::cout << ", Vehicle: " << allocatedVehicleId;
+    const char* vehicleId = getAllocatedVehicleId();
+    if (vehicleId != nullptr) {
+        std::cout << ", Vehicle: " << vehicleId;
     }
     std::cout << std::endl;
 }
@@ -2,21 +2,32 @@
 #include <iostream>
 #include <cstring>
 
-ParkingSystem::ParkingSystem() : nextRequestId(1) {
+ParkingSystem::ParkingSystem() 
+    : requestTable(&vehiclePool, 1), workerPool(nullptr), noShowWheel(time(nullptr)),
+      noShowTimeout(15 * 60), noShowCount(0), defaultStayDuration(2 * 60 * 60),
+      overstayCallback(nullptr), overstayContext(nullptr), waitlistEnabled(false),
+      handoffCount(0), calendarOrigin(time(nullptr) / RESERVATION_BUCKET_SECONDS * RESERVATION_BUCKET_SECONDS),
+      reservationHoldLead(15 * 60), reservationGrace(15 * 60), verbose(true),
+      runningActorSystems(0) {
     rollbackManager = new RollbackManager(this);
     allocationEngine = new AllocationEngine(this, rollbackManager);
-    analyticsEngine = new AnalyticsEngine(&tripHistory, &zones);
+    analyticsEngine = new AnalyticsEngine(&tripHistory, &zones, &cityOccupancy);
 }
 
 ParkingSystem::~ParkingSystem() {
+    stopWorkerPool();
+    
     // Delete zones
     for (int i = 0; i < zones.getSize(); i++) {
         delete zones[i];
     }
     
-    // Delete requests
-    for (int i = 0; i < requests.getSize(); i++) {
-        delete requests[i];
+    // Requests are owned and deleted by requestTable
+    
+    for (int i = 0; i < waitlists.getSize(); i++) {
+        delete waitlists[i];
+        delete bookedCalendars[i];
+        delete pendingCalendars[i];
     }
     
     delete allocationEngine;
@@ -27,80 +38,270 @@ ParkingSystem::~ParkingSystem() {
 void ParkingSystem::addZone(Zone* zone) {
     if (zone != nullptr) {
         zones.add(zone);
+        int index = zoneGraph.addZone(zone);
+        while (waitlists.getSize() <= index) {
+            waitlists.add(new IndexedMinHeap());
+            bookedCalendars.add(nullptr);
+            pendingCalendars.add(nullptr);
+        }
+        zone->attachToSystem(&slotDirectory, &vehiclePool, &cityOccupancy, &zoneGraph);
     }
 }
 
-Zone* ParkingSystem::getZoneById(int zoneId) {
-    for (int i = 0; i < zones.getSize(); i++) {
-        if (zones[i]->getZoneId() == zoneId) {
-            return zones[i];
-        }
+bool ParkingSystem::setReservedCapacity(int zoneId, RequestClass requestClass, int slots) {
+    Zone* zone = getZoneById(zoneId);
+    if (zone == nullptr) {
+        std::cout << "Zone " << zoneId << " not found" << std::endl;
+        return false;
     }
-    return nullptr;
+    zone->setReservedCapacity(requestClass, slots);
+    return true;
+}
+
+bool ParkingSystem::setSlotAttributes(int slotId, unsigned int attributes) {
+    ParkingSlot* slot = slotDirectory.findSlotById(slotId);
+    if (slot == nullptr) {
+        std::cout << "Slot " << slotId << " not found" << std::endl;
+        return false;
+    }
+    Zone* zone = getZoneById(slot->getZoneId());
+    std::lock_guard<Zone> zoneGuard(*zone);
+    slot->setAttributes(attributes);
+    return true;
+}
+
+Zone* ParkingSystem::getZoneById(int zoneId) {
+    return zoneGraph.findZone(zoneId);
 }
 
 int ParkingSystem::getZoneCount() const {
     return zones.getSize();
 }
 
-int ParkingSystem::createRequest(const char* vehicleId, int zoneId) {
-    ParkingRequest* request = new ParkingRequest(nextRequestId, vehicleId, zoneId);
-    requests.add(request);
+std::mutex& ParkingSystem::requestLockFor(int requestId) {
+    return requestLocks[(unsigned int)requestId % REQUEST_LOCK_STRIPES];
+}
+
+int ParkingSystem::createRequest(const char* vehicleId, int zoneId, RequestClass requestClass) {
+    int requestId;
+    {
+        std::lock_guard<std::mutex> registry(registryLock);
+        ParkingRequest* request = requestTable.create(vehiclePool.intern(vehicleId), zoneId);
+        request->setRequestClass(requestClass);
+        activeRequestIndex.insert(request);
+        requestId = request->getRequestId();
+    }
     
-    std::cout << "Created request ID: " << nextRequestId 
-              << " for vehicle " << vehicleId 
-              << " in zone " << zoneId << std::endl;
+    if (verbose) {
+        std::cout << "Created request ID: " << requestId 
+                  << " for vehicle " << vehicleId 
+                  << " in zone " << zoneId << std::endl;
+    }
     
-    return nextRequestId++;
+    return requestId;
+}
+
+int ParkingSystem::submitRequest(const char* vehicleId, int zoneId, RequestClass requestClass) {
+    // Quiet create + enqueue; allocation happens in the next batch
+    std::lock_guard<std::mutex> registry(registryLock);
+    ParkingRequest* request = requestTable.create(vehiclePool.intern(vehicleId), zoneId);
+    request->setRequestClass(requestClass);
+    activeRequestIndex.insert(request);
+    request->setQueued(true);
+    pendingRequests[requestClass].enqueue(request);
+    return request->getRequestId();
+}
+
+bool ParkingSystem::enqueueRequest(int requestId) {
+    ParkingRequest* request = getRequestById(requestId);
+    if (request == nullptr || request->getState() != REQUESTED || request->isQueued()) {
+        return false;
+    }
+    request->setQueued(true);
+    pendingRequests[request->getRequestClass()].enqueue(request);
+    return true;
+}
+
+BatchAllocationResult ParkingSystem::processPendingRequests() {
+    BatchAllocationResult result = allocationEngine->allocateBatch(pendingRequests, REQUEST_CLASS_COUNT);
+    if (result.processed > 0) {
+        std::cout << "Batch allocated " << result.allocated() << " of " << result.processed
+                  << " request(s) (" << result.crossZone << " cross-zone, "
+                  << result.requeued << " re-queued)" << std::endl;
+    }
+    return result;
+}
+
+int ParkingSystem::getPendingCount() const {
+    int pending = 0;
+    for (int c = 0; c < REQUEST_CLASS_COUNT; c++) {
+        pending += pendingRequests[c].getSize();
+    }
+    return pending;
+}
+
+bool ParkingSystem::startWorkerPool(int threads) {
+    if (workerPool != nullptr || threads < 1) {
+        return false;
+    }
+    workerPool = new WorkStealingPool(threads);
+    allocationEngine->setWorkerPool(workerPool);
+    analyticsEngine->setWorkerPool(workerPool);
+    return true;
+}
+
+void ParkingSystem::stopWorkerPool() {
+    if (workerPool == nullptr) return;
+    allocationEngine->setWorkerPool(nullptr);
+    analyticsEngine->setWorkerPool(nullptr);
+    delete workerPool;
+    workerPool = nullptr;
+}
+
+WorkStealingPool* ParkingSystem::getWorkerPool() {
+    return workerPool;
+}
+
+void ParkingSystem::closeRequest(ParkingRequest* request, const TripHistory& trip) {
+    std::lock_guard<std::mutex> registry(registryLock);
+    tripHistory.append(trip);
+    activeRequestIndex.remove(request);
+    requestTable.retire(request);
+}
+
+bool ParkingSystem::reportIfRetired(int requestId) {
+    RequestState finalState;
+    {
+        std::lock_guard<std::mutex> registry(registryLock);
+        const ArchivedRequest* archived = requestTable.getArchived(requestId);
+        if (archived == nullptr) {
+            return false;
+        }
+        finalState = archived->finalState;
+    }
+    std::cout << "Request " << requestId << " is already " 
+              << StateValidator::getStateString(finalState) << std::endl;
+    return true;
 }
 
 bool ParkingSystem::processRequest(int requestId) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
     ParkingRequest* request = getRequestById(requestId);
     if (request == nullptr) {
-        std::cout << "Request " << requestId << " not found" << std::endl;
+        if (!reportIfRetired(requestId)) {
+            std::cout << "Request " << requestId << " not found" << std::endl;
+        }
         return false;
     }
     
-    return allocationEngine->allocateSlot(request);
+    if (allocationEngine->allocateSlot(request)) {
+        if (request->isWaitlisted()) {
+            leaveWaitlist(request);
+        }
+        return true;
+    }
+    
+    if (waitlistEnabled && request->getState() == REQUESTED) {
+        joinWaitlist(request);
+    }
+    return false;
 }
 
-bool ParkingSystem::cancelRequest(int requestId) {
+bool ParkingSystem::setRequiredAttributes(int requestId, unsigned int attributes) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
     ParkingRequest* request = getRequestById(requestId);
     if (request == nullptr) {
+        reportIfRetired(requestId);
+        return false;
+    }
+    if (request->getState() != REQUESTED) {
+        std::cout << "Request " << requestId << " already has a slot" << std::endl;
         return false;
     }
+    request->setRequiredAttributes(attributes);
+    return true;
+}
+
+bool ParkingSystem::setRequiredSlots(int requestId, int slotCount) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+    ParkingRequest* request = getRequestById(requestId);
+    if (request == nullptr) {
+        reportIfRetired(requestId);
+        return false;
+    }
+    if (request->getState() != REQUESTED) {
+        std::cout << "Request " << requestId << " already has a slot" << std::endl;
+        return false;
+    }
+    request->setSlotCount(slotCount);
+    return true;
+}
+
+bool ParkingSystem::cancelRequest(int requestId, bool zoneOwned) {
+    int freedSlotHandle = -1;
+    bool success;
+    {
+        std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+        ParkingRequest* request = getRequestById(requestId);
+        if (request == nullptr) {
+            reportIfRetired(requestId);
+            return false;
+        }
+        success = cancelHeld(request, freedSlotHandle, zoneOwned);
+    }
     
-    bool success = allocationEngine->cancelAllocation(request);
+    if (!zoneOwned) {
+        handOffFreedSlot(freedSlotHandle);
+    }
+    return success;
+}
+
+bool ParkingSystem::cancelHeld(ParkingRequest* request, int& freedSlotHandle, bool zoneOwned) {
+    bool wasAllocated = request->getState() == ALLOCATED;
+    bool success = allocationEngine->cancelAllocation(request, zoneOwned);
     
     if (success) {
+        if (wasAllocated) {
+            freedSlotHandle = request->getAllocatedSlotHandle();
+        }
+        disarmNoShowTimer(request);
+        if (request->isWaitlisted()) {
+            leaveWaitlist(request);
+        }
+        
         // Log cancelled trip
         TripHistory trip;
-        trip.requestId = requestId;
-        int len = strlen(request->getVehicleId());
-        trip.vehicleId = new char[len + 1];
-        strcpy(trip.vehicleId, request->getVehicleId());
+        trip.requestId = request->getRequestId();
+        trip.vehicle = request->getVehicleHandle();
         trip.zoneId = request->getRequestedZoneId();
         trip.startTime = request->getRequestTime();
         trip.endTime = time(nullptr);
         trip.completed = false;
-        tripHistory.append(trip);
+        closeRequest(request, trip);
     }
     
     return success;
 }
 
 ParkingRequest* ParkingSystem::getRequestById(int requestId) {
-    for (int i = 0; i < requests.getSize(); i++) {
-        if (requests[i]->getRequestId() == requestId) {
-            return requests[i];
-        }
-    }
-    return nullptr;
+    // Lock-free; callers that act on the request hold its stripe lock
+    return requestTable.getLive(requestId);
+}
+
+const ArchivedRequest* ParkingSystem::getArchivedRequest(int requestId) const {
+    std::lock_guard<std::mutex> registry(registryLock);
+    return requestTable.getArchived(requestId);
+}
+
+RequestTable* ParkingSystem::getRequestTable() {
+    return &requestTable;
 }
 
 bool ParkingSystem::markVehicleArrived(int requestId) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
     ParkingRequest* request = getRequestById(requestId);
     if (request == nullptr) {
+        reportIfRetired(requestId);
         return false;
     }
     
@@ -109,73 +310,733 @@ bool ParkingSystem::markVehicleArrived(int requestId) {
         return false;
     }
     
-    return request->markOccupied();
+    if (!request->markOccupied()) {
+        return false;
+    }
+    disarmNoShowTimer(request);
+    
+    std::lock_guard<std::mutex> guard(stayLock);
+    stayHeap.push(requestId, expectedExitTime(request));
+    return true;
 }
 
-bool ParkingSystem::markVehicleExited(int requestId) {
+int ParkingSystem::getRequestSlot(int requestId, RequestState& state) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
     ParkingRequest* request = getRequestById(requestId);
     if (request == nullptr) {
-        return false;
+        state = CANCELLED;
+        return -1;
+    }
+    state = request->getState();
+    return request->getAllocatedSlotHandle();
+}
+
+bool ParkingSystem::markVehicleExited(int requestId, bool zoneOwned) {
+    int freedSlotHandle;
+    bool success;
+    {
+        std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+        ParkingRequest* request = getRequestById(requestId);
+        if (request == nullptr) {
+            reportIfRetired(requestId);
+            return false;
+        }
+        
+        if (request->getState() != OCCUPIED) {
+            std::cout << "Request must be in OCCUPIED state" << std::endl;
+            return false;
+        }
+        
+        // Release the slot
+        freedSlotHandle = request->getAllocatedSlotHandle();
+        releaseRequestSlot(request, zoneOwned);
+        
+        // Mark request as released
+        success = request->markReleased();
+        
+        if (success) {
+            {
+                std::lock_guard<std::mutex> guard(stayLock);
+                stayHeap.remove(requestId);
+            }
+            
+            // Log completed trip
+            TripHistory trip;
+            trip.requestId = requestId;
+            trip.vehicle = request->getVehicleHandle();
+            trip.zoneId = request->getRequestedZoneId();
+            trip.startTime = request->getOccupiedTime();
+            trip.endTime = request->getReleaseTime();
+            trip.completed = true;
+            closeRequest(request, trip);
+        }
     }
     
-    if (request->getState() != OCCUPIED) {
-        std::cout << "Request must be in OCCUPIED state" << std::endl;
+    // Outside the stripe lock: the handoff takes the waiter's stripe
+    if (!zoneOwned) {
+        handOffFreedSlot(freedSlotHandle);
+    }
+    return success;
+}
+
+void ParkingSystem::armNoShowTimer(ParkingRequest* request) {
+    if (noShowTimeout <= 0) return;
+    
+    std::lock_guard<std::mutex> guard(noShowLock);
+    noShowWheel.cancel(request->getExpiryTimer());  // Re-allocated after a rollback
+    request->setExpiryTimer(noShowWheel.schedule(request->getAllocationTime() + noShowTimeout,
+                                                 request->getRequestId()));
+}
+
+void ParkingSystem::disarmNoShowTimer(ParkingRequest* request) {
+    std::lock_guard<std::mutex> guard(noShowLock);
+    noShowWheel.cancel(request->getExpiryTimer());
+    request->setExpiryTimer(NO_TIMER);
+}
+
+int ParkingSystem::expireNoShows(long long now) {
+    if (refusedWhileActorsRun("expireNoShows")) return 0;
+    DynamicArray<ExpiredTimer> due;
+    {
+        std::lock_guard<std::mutex> guard(noShowLock);
+        noShowWheel.advance(now, due);
+    }
+    
+    int expired = 0;
+    DynamicArray<int> freedSlots;
+    for (int i = 0; i < due.getSize(); i++) {
+        int requestId = due[i].payload;
+        std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+        ParkingRequest* request = getRequestById(requestId);
+        if (request == nullptr) continue;
+        
+        // Skip timers superseded by a later allocation of the same request
+        {
+            std::lock_guard<std::mutex> guard(noShowLock);
+            if (request->getExpiryTimer() != due[i].handle) continue;
+            request->setExpiryTimer(NO_TIMER);
+        }
+        if (request->getState() != ALLOCATED) continue;
+        
+        int freedSlotHandle = -1;
+        if (cancelHeld(request, freedSlotHandle)) {
+            freedSlots.add(freedSlotHandle);
+            expired++;
+        }
+    }
+    
+    for (int i = 0; i < freedSlots.getSize(); i++) {
+        handOffFreedSlot(freedSlots[i]);
+    }
+    
+    if (expired > 0) {
+        noShowCount.fetch_add(expired);
+        std::cout << "Expired " << expired << " no-show allocation(s)" << std::endl;
+    }
+    return expired;
+}
+
+void ParkingSystem::setNoShowTimeout(int seconds) {
+    noShowTimeout = seconds < 0 ? 0 : seconds;
+}
+
+int ParkingSystem::getNoShowTimeout() const {
+    return noShowTimeout;
+}
+
+long long ParkingSystem::getNoShowCount() const {
+    return noShowCount.load();
+}
+
+int ParkingSystem::getPendingNoShowTimers() const {
+    std::lock_guard<std::mutex> guard(noShowLock);
+    return noShowWheel.getActiveCount();
+}
+
+long long ParkingSystem::expectedExitTime(const ParkingRequest* request) const {
+    long long duration = request->getBookedDuration();
+    if (duration <= 0) duration = defaultStayDuration;
+    return request->getOccupiedTime() + duration;
+}
+
+bool ParkingSystem::setBookedDuration(int requestId, long long seconds) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+    ParkingRequest* request = getRequestById(requestId);
+    if (request == nullptr) {
+        reportIfRetired(requestId);
         return false;
     }
     
-    // Release the slot
-    int slotId = request->getAllocatedSlotId();
-    ParkingSlot* slot = findSlotById(slotId);
-    if (slot != nullptr) {
-        slot->release();
+    request->setBookedDuration(seconds);
+    if (request->getState() == OCCUPIED) {
+        // Extended or shortened mid-stay: re-key and allow a fresh notification
+        request->setOverstayFlagged(false);
+        std::lock_guard<std::mutex> guard(stayLock);
+        stayHeap.push(requestId, expectedExitTime(request));
     }
+    return true;
+}
+
+void ParkingSystem::setDefaultStayDuration(long long seconds) {
+    defaultStayDuration = seconds < 1 ? 1 : seconds;
+}
+
+long long ParkingSystem::getDefaultStayDuration() const {
+    return defaultStayDuration;
+}
+
+void ParkingSystem::setOverstayCallback(OverstayCallback callback, void* context) {
+    overstayCallback = callback;
+    overstayContext = context;
+}
+
+int ParkingSystem::collectOverstays(long long now, DynamicArray<int>& requestIds) {
+    std::lock_guard<std::mutex> guard(stayLock);
+    return stayHeap.collectAtMost(now - 1, requestIds);
+}
+
+int ParkingSystem::checkOverstays(long long now) {
+    DynamicArray<int> overdue;
+    collectOverstays(now, overdue);
     
-    // Mark request as released
-    bool success = request->markReleased();
+    // Flag under each request's stripe lock, fire afterwards so the hook may call back in
+    DynamicArray<int> flaggedIds;
+    DynamicArray<long long> flaggedBy;
+    for (int i = 0; i < overdue.getSize(); i++) {
+        int requestId = overdue[i];
+        std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+        ParkingRequest* request = getRequestById(requestId);
+        if (request == nullptr || request->getState() != OCCUPIED) {
+            std::lock_guard<std::mutex> guard(stayLock);
+            stayHeap.remove(requestId);
+            continue;
+        }
+        if (request->isOverstayFlagged()) continue;
+        
+        request->setOverstayFlagged(true);
+        flaggedIds.add(requestId);
+        flaggedBy.add(now - expectedExitTime(request));
+    }
     
-    if (success) {
-        // Log completed trip
-        TripHistory trip;
-        trip.requestId = requestId;
-        int len = strlen(request->getVehicleId());
-        trip.vehicleId = new char[len + 1];
-        strcpy(trip.vehicleId, request->getVehicleId());
-        trip.zoneId = request->getRequestedZoneId();
-        trip.startTime = request->getOccupiedTime();
-        trip.endTime = request->getReleaseTime();
-        trip.completed = true;
-        tripHistory.append(trip);
+    if (overstayCallback != nullptr) {
+        for (int i = 0; i < flaggedIds.getSize(); i++) {
+            overstayCallback(flaggedIds[i], flaggedBy[i], overstayContext);
+        }
     }
+    return flaggedIds.getSize();
+}
+
+int ParkingSystem::getTrackedStayCount() const {
+    std::lock_guard<std::mutex> guard(stayLock);
+    return stayHeap.getSize();
+}
+
+long long ParkingSystem::waitlistKey(const ParkingRequest* request) {
+    // Higher priority first, then request order (IDs are issued in request time order)
+    return ((long long)(MAX_REQUEST_PRIORITY - request->getPriority()) << 40) | request->getRequestId();
+}
+
+bool ParkingSystem::joinWaitlist(ParkingRequest* request) {
+    int index = zoneGraph.findZoneIndex(request->getRequestedZoneId());
+    if (index < 0) return false;
     
-    return success;
+    int waiting;
+    {
+        std::lock_guard<std::mutex> guard(waitlistLock);
+        waitlists[index]->push(request->getRequestId(), waitlistKey(request));
+        waiting = waitlists[index]->getSize();
+    }
+    request->setWaitlisted(true);
+    std::cout << "Request " << request->getRequestId() << " waitlisted for zone " 
+              << request->getRequestedZoneId() << " (" << waiting << " waiting)" << std::endl;
+    return true;
 }
 
-bool ParkingSystem::rollbackOperations(int k) {
-    return rollbackManager->rollback(k);
+void ParkingSystem::leaveWaitlist(ParkingRequest* request) {
+    int index = zoneGraph.findZoneIndex(request->getRequestedZoneId());
+    request->setWaitlisted(false);
+    if (index < 0) return;
+    
+    std::lock_guard<std::mutex> guard(waitlistLock);
+    waitlists[index]->remove(request->getRequestId());
 }
 
-ParkingSlot* ParkingSystem::findSlotById(int slotId) {
-    for (int i = 0; i < zones.getSize(); i++) {
-        for (int j = 0; j < zones[i]->getAreaCount(); j++) {
-            ParkingArea* area = zones[i]->getAreaByIndex(j);
-            if (area != nullptr) {
-                ParkingSlot* slot = area->getSlotById(slotId);
-                if (slot != nullptr) {
-                    return slot;
-                }
+bool ParkingSystem::canFallBackTo(int fromIndex, int toIndex) {
+    int maxHops = allocationEngine->getMaxFallbackHops();
+    int maxCost = allocationEngine->getMaxFallbackCost();
+    const ZoneFallback* fallbacks = zoneGraph.getFallbacks(fromIndex);
+    int count = zoneGraph.getFallbackCount(fromIndex);
+    for (int i = 0; i < count; i++) {
+        if (fallbacks[i].zoneIndex != toIndex) continue;
+        return (maxCost < 0 || fallbacks[i].cost <= maxCost) &&
+               (maxHops < 0 || fallbacks[i].hops <= maxHops);
+    }
+    return false;
+}
+
+bool ParkingSystem::handOffToZone(int zoneIndex) {
+    Zone* zone = zoneGraph.getZone(zoneIndex);
+    if (zone == nullptr) return false;
+    
+    // The zone's own waiters first, then waiters in nearby zones allowed to fall back into it.
+    // Waiters whose required attributes, run or class no free slots here fit are passed over, not dropped.
+    const ZoneFallback* nearby = zoneGraph.getFallbacks(zoneIndex);
+    int candidates = 1 + zoneGraph.getFallbackCount(zoneIndex);
+    DynamicArray<int> passedOver;
+    DynamicArray<long long> passedOverKeys;
+    DynamicArray<int> passedOverLists;
+    bool handed = false;
+    bool stop = false;
+    for (int c = 0; c < candidates && !handed && !stop; c++) {
+        int waitIndex = (c == 0) ? zoneIndex : nearby[c - 1].zoneIndex;
+        if (c > 0 && !canFallBackTo(waitIndex, zoneIndex)) continue;
+        
+        while (true) {
+            int requestId;
+            {
+                std::lock_guard<std::mutex> guard(waitlistLock);
+                requestId = waitlists[waitIndex]->pop();
+            }
+            if (requestId == -1) break;
+            
+            std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+            ParkingRequest* request = getRequestById(requestId);
+            if (request == nullptr || !request->isWaitlisted() || request->getState() != REQUESTED) {
+                continue;   // Stale entry: served or cancelled another way
+            }
+            
+            ParkingSlot* slot = allocationEngine->allocateInZone(request, zone, c > 0);
+            if (slot == nullptr) {
+                // No matching slot (or a direct request took it first): the waiter keeps its place
+                passedOver.add(requestId);
+                passedOverKeys.add(waitlistKey(request));
+                passedOverLists.add(waitIndex);
+                if (request->getRequiredAttributes() != 0 || request->getSlotCount() > 1) continue;
+                // A plain waiter refused while slots are still free was held off by a
+                // higher class's reserve (or a booking); a waiter of another class may fit
+                if (zone->getOccupancy()->getAvailableSlots() > 0) continue;
+                stop = true;
+                break;
             }
+            
+            request->setWaitlisted(false);
+            handoffCount.fetch_add(1);
+            std::cout << "Handed slot " << slot->getSlotId() << " in zone " << zone->getZoneId()
+                      << " to waitlisted request " << requestId << std::endl;
+            handed = true;
+            break;
         }
     }
-    return nullptr;
+    
+    std::lock_guard<std::mutex> guard(waitlistLock);
+    for (int i = 0; i < passedOver.getSize(); i++) {
+        waitlists[passedOverLists[i]]->push(passedOver[i], passedOverKeys[i]);
+    }
+    return handed;
 }
 
-ParkingRequest* ParkingSystem::findRequestByVehicle(const char* vehicleId) {
-    for (int i = 0; i < requests.getSize(); i++) {
-        if (strcmp(requests[i]->getVehicleId(), vehicleId) == 0) {
-            return requests[i];
+void ParkingSystem::handOffFreedSlot(int slotHandle) {
+    if (!waitlistEnabled || slotHandle < 0) return;
+    if (refusedWhileActorsRun("Waitlist handoff")) return;
+    
+    Zone* zone = slotDirectory.getZone(slotHandle);
+    if (zone == nullptr) return;
+    int index = zoneGraph.findZoneIndex(zone->getZoneId());
+    if (index < 0) return;
+    
+    // A freed run frees several slots; keep handing off while any are left
+    while (zone->getOccupancy()->getAvailableSlots() > 0 && handOffToZone(index)) {
+    }
+}
+
+int ParkingSystem::serveWaitlists() {
+    if (!waitlistEnabled) return 0;
+    if (refusedWhileActorsRun("serveWaitlists")) return 0;
+    
+    int served = 0;
+    for (int i = 0; i < zoneGraph.getZoneCount(); i++) {
+        Zone* zone = zoneGraph.getZone(i);
+        while (zone->getOccupancy()->getAvailableSlots() > 0 && handOffToZone(i)) {
+            served++;
         }
     }
-    return nullptr;
+    return served;
+}
+
+void ParkingSystem::setVerbose(bool enabled) {
+    verbose = enabled;
+}
+
+bool ParkingSystem::isVerbose() const {
+    return verbose;
+}
+
+void ParkingSystem::setZoneActorsRunning(bool running) {
+    runningActorSystems.fetch_add(running ? 1 : -1);
+}
+
+bool ParkingSystem::refusedWhileActorsRun(const char* operation) const {
+#ifndef NDEBUG
+    // These paths write slots under the shard lock, which actors never take
+    if (runningActorSystems.load() > 0) {
+        std::cout << operation << " refused: zone actors own the slots" << std::endl;
+        return true;
+    }
+#else
+    (void)operation;
+#endif
+    return false;
+}
+
+void ParkingSystem::setWaitlistEnabled(bool enabled) {
+    waitlistEnabled = enabled;
+}
+
+bool ParkingSystem::isWaitlistEnabled() const {
+    return waitlistEnabled;
+}
+
+bool ParkingSystem::setRequestPriority(int requestId, int priority) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+    ParkingRequest* request = getRequestById(requestId);
+    if (request == nullptr) {
+        reportIfRetired(requestId);
+        return false;
+    }
+    
+    request->setPriority(priority);
+    if (request->isWaitlisted()) {
+        int index = zoneGraph.findZoneIndex(request->getRequestedZoneId());
+        std::lock_guard<std::mutex> guard(waitlistLock);
+        waitlists[index]->push(requestId, waitlistKey(request));
+    }
+    return true;
+}
+
+int ParkingSystem::getWaitlistLength(int zoneId) const {
+    int index = zoneGraph.findZoneIndex(zoneId);
+    if (index < 0) return 0;
+    std::lock_guard<std::mutex> guard(waitlistLock);
+    return waitlists[index]->getSize();
+}
+
+long long ParkingSystem::getHandoffCount() const {
+    return handoffCount.load();
+}
+
+void ParkingSystem::ensureCalendars(int zoneIndex) {
+    if (bookedCalendars[zoneIndex] == nullptr) {
+        bookedCalendars[zoneIndex] = new ReservationCalendar(calendarOrigin, RESERVATION_BUCKET_SECONDS, 
+                                                             RESERVATION_BUCKETS);
+        pendingCalendars[zoneIndex] = new ReservationCalendar(calendarOrigin, RESERVATION_BUCKET_SECONDS, 
+                                                              RESERVATION_BUCKETS);
+    }
+}
+
+int ParkingSystem::reserve(const char* vehicleId, int zoneId, long long startTime, long long endTime) {
+    int index = zoneGraph.findZoneIndex(zoneId);
+    if (index < 0) {
+        std::cout << "Zone " << zoneId << " not found" << std::endl;
+        return -1;
+    }
+    Zone* zone = zoneGraph.getZone(index);
+    
+    std::lock_guard<std::mutex> guard(reservationLock);
+    int reservationId = reservations.getSize();
+    {
+        std::lock_guard<Zone> zoneGuard(*zone);
+        ensureCalendars(index);
+        if (!bookedCalendars[index]->covers(startTime, endTime)) {
+            std::cout << "Reservation window is outside the booking horizon" << std::endl;
+            return -1;
+        }
+        if (bookedCalendars[index]->getMaxBooked(startTime, endTime) >= zone->getBookableSlots()) {
+            std::cout << "Zone " << zoneId << " is fully booked for that window" << std::endl;
+            return -1;
+        }
+        bookedCalendars[index]->addBooking(startTime, endTime, 1);
+        pendingCalendars[index]->addBooking(startTime, endTime, 1);
+    }
+    
+    Reservation reservation;
+    reservation.reservationId = reservationId;
+    {
+        std::lock_guard<std::mutex> registry(registryLock);
+        reservation.vehicle = vehiclePool.intern(vehicleId);
+    }
+    reservation.zoneId = zoneId;
+    reservation.startTime = startTime;
+    reservation.endTime = endTime;
+    reservation.state = RESERVATION_BOOKED;
+    reservations.add(reservation);
+    reservationStarts.push(reservationId, startTime - reservationHoldLead);
+    return reservationId;
+}
+
+bool ParkingSystem::isZoneAvailable(int zoneId, long long startTime, long long endTime) {
+    int index = zoneGraph.findZoneIndex(zoneId);
+    if (index < 0) return false;
+    Zone* zone = zoneGraph.getZone(index);
+    
+    std::lock_guard<Zone> zoneGuard(*zone);
+    ensureCalendars(index);
+    return bookedCalendars[index]->covers(startTime, endTime) &&
+           bookedCalendars[index]->getMaxBooked(startTime, endTime) < zone->getBookableSlots();
+}
+
+bool ParkingSystem::holdReservation(Reservation& reservation) {
+    int index = zoneGraph.findZoneIndex(reservation.zoneId);
+    Zone* zone = zoneGraph.getZone(index);
+    
+    std::lock_guard<Zone> zoneGuard(*zone);
+    if (!zone->admits(CLASS_STANDARD)) {
+        return false;   // Only higher classes' reserves are free
+    }
+    ParkingSlot* slot = zone->findAvailableSlot();
+    if (slot == nullptr || !slot->setStatus(SLOT_RESERVED)) {
+        return false;
+    }
+    reservation.slotHandle = slot->getSlotHandle();
+    reservation.state = RESERVATION_HELD;
+    pendingCalendars[index]->addBooking(reservation.startTime, reservation.endTime, -1);
+    return true;
+}
+
+void ParkingSystem::releaseHold(Reservation& reservation) {
+    int index = zoneGraph.findZoneIndex(reservation.zoneId);
+    Zone* zone = zoneGraph.getZone(index);
+    
+    std::lock_guard<Zone> zoneGuard(*zone);
+    ParkingSlot* slot = slotDirectory.getSlot(reservation.slotHandle);
+    if (slot != nullptr && slot->getStatus() == SLOT_RESERVED) {
+        slot->setStatus(SLOT_AVAILABLE);
+    }
+    bookedCalendars[index]->addBooking(reservation.startTime, reservation.endTime, -1);
+    reservation.slotHandle = -1;
+}
+
+void ParkingSystem::dropBooking(Reservation& reservation) {
+    int index = zoneGraph.findZoneIndex(reservation.zoneId);
+    Zone* zone = zoneGraph.getZone(index);
+    
+    std::lock_guard<Zone> zoneGuard(*zone);
+    bookedCalendars[index]->addBooking(reservation.startTime, reservation.endTime, -1);
+    pendingCalendars[index]->addBooking(reservation.startTime, reservation.endTime, -1);
+}
+
+int ParkingSystem::advanceReservations(long long now) {
+    if (refusedWhileActorsRun("advanceReservations")) return 0;
+    int changed = 0;
+    std::lock_guard<std::mutex> guard(reservationLock);
+    
+    // Hold a slot for every booking about to start
+    DynamicArray<int> deferred;
+    while (!reservationStarts.isEmpty() && reservationStarts.topKey() <= now) {
+        int reservationId = reservationStarts.pop();
+        Reservation& reservation = reservations[reservationId];
+        if (reservation.startTime + reservationGrace <= now) {
+            // Deferred past its grace period: the slot would only be released again
+            dropBooking(reservation);
+            reservation.state = RESERVATION_EXPIRED;
+            changed++;
+            continue;
+        }
+        if (!holdReservation(reservation)) {
+            deferred.add(reservationId);    // Zone still full (overstays): retry on the next call
+            continue;
+        }
+        reservationHolds.push(reservationId, reservation.startTime + reservationGrace);
+        changed++;
+    }
+    for (int i = 0; i < deferred.getSize(); i++) {
+        reservationStarts.push(deferred[i], now + 1);
+    }
+    
+    // Give back holds nobody claimed
+    while (!reservationHolds.isEmpty() && reservationHolds.topKey() <= now) {
+        Reservation& reservation = reservations[reservationHolds.pop()];
+        releaseHold(reservation);
+        reservation.state = RESERVATION_EXPIRED;
+        changed++;
+    }
+    return changed;
+}
+
+int ParkingSystem::checkInReservation(int reservationId) {
+    if (refusedWhileActorsRun("checkInReservation")) return -1;
+    std::lock_guard<std::mutex> guard(reservationLock);
+    if (reservationId < 0 || reservationId >= reservations.getSize()) {
+        std::cout << "Reservation " << reservationId << " not found" << std::endl;
+        return -1;
+    }
+    Reservation& reservation = reservations[reservationId];
+    if (reservation.state == RESERVATION_BOOKED) {
+        // Early arrival: hold a slot now if one is free
+        if (!holdReservation(reservation)) {
+            std::cout << "No slot free yet for reservation " << reservationId << std::endl;
+            return -1;
+        }
+        reservationStarts.remove(reservationId);
+        reservationHolds.push(reservationId, reservation.startTime + reservationGrace);
+    } else if (reservation.state != RESERVATION_HELD) {
+        std::cout << "Reservation " << reservationId << " cannot be checked in" << std::endl;
+        return -1;
+    }
+    
+    const char* vehicleId;
+    {
+        std::lock_guard<std::mutex> registry(registryLock);
+        vehicleId = vehiclePool.getString(reservation.vehicle);   // Pool strings never move
+    }
+    int requestId = createRequest(vehicleId, reservation.zoneId);
+    bool allocated;
+    {
+        std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+        ParkingRequest* request = getRequestById(requestId);
+        allocated = allocationEngine->allocateReservedSlot(request, reservation.slotHandle);
+    }
+    if (!allocated) {
+        // The held slot was taken out of service: drop the request, and leave
+        // the hold queued so advanceReservations expires it
+        cancelRequest(requestId);
+        std::cout << "Held slot for reservation " << reservationId << " is no longer reserved" << std::endl;
+        return -1;
+    }
+    
+    reservationHolds.remove(reservationId);
+    reservation.state = RESERVATION_CHECKED_IN;
+    reservation.requestId = requestId;
+    return requestId;
+}
+
+bool ParkingSystem::cancelReservation(int reservationId) {
+    if (refusedWhileActorsRun("cancelReservation")) return false;
+    std::lock_guard<std::mutex> guard(reservationLock);
+    if (reservationId < 0 || reservationId >= reservations.getSize()) {
+        return false;
+    }
+    Reservation& reservation = reservations[reservationId];
+    if (reservation.state == RESERVATION_BOOKED) {
+        dropBooking(reservation);
+        reservationStarts.remove(reservationId);
+    } else if (reservation.state == RESERVATION_HELD) {
+        releaseHold(reservation);
+        reservationHolds.remove(reservationId);
+    } else {
+        std::cout << "Reservation " << reservationId << " cannot be cancelled" << std::endl;
+        return false;
+    }
+    reservation.state = RESERVATION_CANCELLED;
+    return true;
+}
+
+ReservationState ParkingSystem::getReservationState(int reservationId) const {
+    std::lock_guard<std::mutex> guard(reservationLock);
+    if (reservationId < 0 || reservationId >= reservations.getSize()) {
+        return RESERVATION_NONE;
+    }
+    return reservations[reservationId].state;
+}
+
+void ParkingSystem::setReservationHoldWindow(int leadSeconds, int graceSeconds) {
+    reservationHoldLead = leadSeconds < 0 ? 0 : leadSeconds;
+    reservationGrace = graceSeconds < 0 ? 0 : graceSeconds;
+}
+
+int ParkingSystem::getReservationHoldback(Zone* zone, long long from, long long until) {
+    int index = zoneGraph.findZoneIndex(zone->getZoneId());
+    if (index < 0 || pendingCalendars[index] == nullptr) return 0;
+    return pendingCalendars[index]->getMaxBooked(from, until);
+}
+
+bool ParkingSystem::rollbackOperations(int k) {
+    bool success = rollbackManager->rollback(k);
+    if (success) {
+        // Rolled-back slots are free again
+        serveWaitlists();
+    }
+    return success;
+}
+
+bool ParkingSystem::undoAllocation(int requestId, int slotId) {
+    std::lock_guard<std::mutex> requestGuard(requestLockFor(requestId));
+    ParkingRequest* request = getRequestById(requestId);
+    if (request == nullptr || request->getState() != ALLOCATED || 
+        request->getAllocatedSlotId() != slotId) {
+        return false;
+    }
+    
+    // Same release as an exit (whole run, class refund), then detach
+    releaseRequestSlot(request);
+    disarmNoShowTimer(request);
+    return request->revertAllocation();
+}
+
+bool ParkingSystem::releaseSlot(int slotHandle) {
+    ParkingSlot* slot = slotDirectory.getSlot(slotHandle);
+    if (slot == nullptr) return false;
+    
+    Zone* zone = slotDirectory.getZone(slotHandle);
+    if (zone == nullptr) return slot->release();
+    std::lock_guard<Zone> guard(*zone);
+    return slot->release();
+}
+
+bool ParkingSystem::releaseRequestSlot(ParkingRequest* request, bool zoneOwned) {
+    int slotHandle = request->getAllocatedSlotHandle();
+    ParkingSlot* slot = slotDirectory.getSlot(slotHandle);
+    if (slot == nullptr) return false;
+    
+    Zone* zone = slotDirectory.getZone(slotHandle);
+    if (zone == nullptr) return slot->release();
+    std::unique_lock<Zone> guard(*zone, std::defer_lock);
+    if (!zoneOwned) {
+        guard.lock();
+    }
+    int length = request->getSlotCount();
+    if (request->isClassCharged()) {
+        zone->refundClass(request->getRequestClass(), length);
+        request->setClassCharged(false);
+    }
+    if (length > 1) {
+        return slot->getArea()->releaseRun(slot->getSlotIndex(), length);
+    }
+    return slot->release();
+}
+
+ParkingSlot* ParkingSystem::findSlotById(int slotId) {
+    return slotDirectory.findSlotById(slotId);
+}
+
+ParkingSlot* ParkingSystem::findSlotByHandle(int slotHandle) {
+    return slotDirectory.getSlot(slotHandle);
+}
+
+SlotDirectory* ParkingSystem::getSlotDirectory() {
+    return &slotDirectory;
+}
+
+ZoneGraph* ParkingSystem::getZoneGraph() {
+    return &zoneGraph;
+}
+
+ParkingRequest* ParkingSystem::findRequestByVehicle(const char* vehicleId) {
+    // A plate never interned has no request
+    std::lock_guard<std::mutex> registry(registryLock);
+    return activeRequestIndex.find(vehiclePool.find(vehicleId));
+}
+
+ParkingRequest* ParkingSystem::findRequestByVehicle(VehicleHandle vehicle) {
+    std::lock_guard<std::mutex> registry(registryLock);
+    return activeRequestIndex.find(vehicle);
+}
+
+VehicleIdPool* ParkingSystem::getVehiclePool() {
+    return &vehiclePool;
+}
+
+int ParkingSystem::getActiveVehicleCount() const {
+    return activeRequestIndex.getSize();
 }
 
 float ParkingSystem::getAverageParkingDuration() {
@@ -200,16 +1061,24 @@ float ParkingSystem::getZoneUtilization(int zoneId) {
 }
 
 float ParkingSystem::getSystemUtilization() {
-    int totalSlots = 0;
-    int occupiedSlots = 0;
-    
+    return cityOccupancy.getUtilization();
+}
+
+const OccupancyCounter* ParkingSystem::getCityOccupancy() const {
+    return &cityOccupancy;
+}
+
+SlotStatusCounts ParkingSystem::auditSlotStatuses(KernelLevel level) {
+    // Full-city recount straight from the slot status columns
+    SlotStatusCounts totals;
     for (int i = 0; i < zones.getSize(); i++) {
-        totalSlots += zones[i]->getTotalSlots();
-        occupiedSlots += zones[i]->getOccupiedSlots();
+        SlotStatusCounts counts = zones[i]->getStatusCounts(level);
+        totals.available += counts.available;
+        totals.occupied += counts.occupied;
+        totals.reserved += counts.reserved;
+        totals.maintenance += counts.maintenance;
     }
-    
-    if (totalSlots == 0) return 0.0f;
-    return (float)occupiedSlots / totalSlots;
+    return totals;
 }
 
 int ParkingSystem::getPeakUsageZone() {
@@ -245,7 +1114,7 @@ float ParkingSystem::getCancelledRatio() {
 }
 
 int ParkingSystem::getTotalRequests() const {
-    return requests.getSize();
+    return requestTable.getTotalCount();
 }
 
 int ParkingSystem::getCompletedTrips() const {
@@ -294,9 +1163,7 @@ void ParkingSystem::displayAllZones() {
 
 void ParkingSystem::displayAllRequests() {
     std::cout << "\n===== ALL REQUESTS =====" << std::endl;
-    for (int i = 0; i < requests.getSize(); i++) {
-        requests[i]->displayRequestInfo();
-    }
+    requestTable.displayAll();
     std::cout << "========================\n" << std::endl;
 }
 
@@ -306,7 +1173,7 @@ void ParkingSystem::displayTripHistory() {
     for (auto it = tripHistory.begin(); it != tripHistory.end(); ++it) {
         count++;
         std::cout << count << ". Request " << (*it).requestId 
-                  << ", Vehicle: " << (*it).vehicleId
+                  << ", Vehicle: " << vehiclePool.getString((*it).vehicle)
                   << ", Zone: " << (*it).zoneId
                   << ", Duration: " << ((*it).endTime - (*it).startTime) << "s"
                   << ", Status: " << ((*it).completed ? "COMPLETED" : "CANCELLED")
@@ -322,6 +1189,14 @@ AnalyticsEngine* ParkingSystem::getAnalyticsEngine() {
     return analyticsEngine;
 }
 
+AllocationEngine* ParkingSystem::getAllocationEngine() {
+    return allocationEngine;
+}
+
+RollbackManager* ParkingSystem::getRollbackManager() {
+    return rollbackManager;
+}
+
 void ParkingSystem::generateAnalyticsSummary() {
     analyticsEngine->generateSummaryReport();
 }
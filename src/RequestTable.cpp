@@ -0,0 +1,226 @@
+#include "include/RequestTable.h"
+#include <iostream>
+
+long long ArchivedRequest::getParkingDuration() const {
+    if (occupiedTime > 0 && releaseTime > 0) {
+        return releaseTime - occupiedTime;
+    }
+    return 0;
+}
+
+void ArchivedRequest::displayRequestInfo(const VehicleIdPool* pool) const {
+    std::cout << "Request ID: " << requestId
+              << ", Vehicle: " << pool->getString(vehicle)
+              << ", Requested Zone: " << requestedZoneId
+              << ", State: " << StateValidator::getStateString(finalState);
+
+    if (allocatedSlotId != -1) {
+        std::cout << ", Slot: " << allocatedSlotId;
+        if (crossZoneAllocation) {
+            std::cout << " (Cross-Zone)";
+        }
+    }
+
+    if (finalState == RELEASED) {
+        std::cout << ", Duration: " << getParkingDuration() << "s";
+    }
+
+    std::cout << std::endl;
+}
+
+RequestTable::RequestTable(const VehicleIdPool* pool, int firstId)
+    : entryChunks(nullptr), entryChunkCapacity(4), entryCount(0), firstRequestId(firstId),
+      chunkCapacity(4), archivedCount(0), freeList(16), liveCount(0),
+      vehiclePool(pool) {
+    Entry** directory = new Entry*[entryChunkCapacity];
+    for (int i = 0; i < entryChunkCapacity; i++) {
+        directory[i] = nullptr;
+    }
+    entryChunks.store(directory);
+    archiveChunks = new ArchivedRequest*[chunkCapacity];
+    for (int i = 0; i < chunkCapacity; i++) {
+        archiveChunks[i] = nullptr;
+    }
+}
+
+RequestTable::~RequestTable() {
+    Entry** directory = entryChunks.load();
+    int count = entryCount.load();
+    for (int i = 0; i < count; i++) {
+        delete directory[i / ENTRY_CHUNK_SIZE][i % ENTRY_CHUNK_SIZE].live.load();
+    }
+    for (int i = 0; i < entryChunkCapacity; i++) {
+        delete[] directory[i];
+    }
+    delete[] directory;
+    for (int i = 0; i < replacedDirectories.getSize(); i++) {
+        delete[] replacedDirectories[i];
+    }
+
+    for (int i = 0; i < chunkCapacity; i++) {
+        if (archiveChunks[i] != nullptr) {
+            delete[] archiveChunks[i];
+        }
+    }
+    delete[] archiveChunks;
+
+    for (int i = 0; i < freeList.getSize(); i++) {
+        delete freeList[i];
+    }
+}
+
+RequestTable::Entry* RequestTable::getEntry(int requestId) const {
+    int index = requestId - firstRequestId;
+    if (index < 0 || index >= entryCount.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    Entry** directory = entryChunks.load(std::memory_order_acquire);
+    return &directory[index / ENTRY_CHUNK_SIZE][index % ENTRY_CHUNK_SIZE];
+}
+
+ArchivedRequest* RequestTable::archiveSlot(int archiveIndex) const {
+    return &archiveChunks[archiveIndex / ARCHIVE_CHUNK_SIZE][archiveIndex % ARCHIVE_CHUNK_SIZE];
+}
+
+ParkingRequest* RequestTable::create(VehicleHandle vehicle, int zoneId) {
+    int index = entryCount.load(std::memory_order_relaxed);
+    int chunk = index / ENTRY_CHUNK_SIZE;
+    Entry** directory = entryChunks.load(std::memory_order_relaxed);
+    if (chunk >= entryChunkCapacity) {
+        // Chunks are shared by both directories; only the pointer array is copied
+        int newCapacity = entryChunkCapacity * 2;
+        Entry** grown = new Entry*[newCapacity];
+        for (int i = 0; i < newCapacity; i++) {
+            grown[i] = (i < entryChunkCapacity) ? directory[i] : nullptr;
+        }
+        replacedDirectories.add(directory);
+        directory = grown;
+        entryChunkCapacity = newCapacity;
+        entryChunks.store(directory, std::memory_order_release);
+    }
+    if (directory[chunk] == nullptr) {
+        directory[chunk] = new Entry[ENTRY_CHUNK_SIZE];
+    }
+
+    int requestId = firstRequestId + index;
+    ParkingRequest* request;
+    if (!freeList.isEmpty()) {
+        // Reuse a retired request object
+        request = freeList[freeList.getSize() - 1];
+        freeList.remove(freeList.getSize() - 1);
+        request->reset(requestId, vehicle, zoneId);
+    } else {
+        request = new ParkingRequest(requestId, vehicle, zoneId, vehiclePool);
+    }
+
+    // The entry is complete before the count that makes it visible
+    Entry& entry = directory[chunk][index % ENTRY_CHUNK_SIZE];
+    entry.live.store(request, std::memory_order_relaxed);
+    entry.archiveIndex = -1;
+    entryCount.store(index + 1, std::memory_order_release);
+    liveCount++;
+    return request;
+}
+
+bool RequestTable::retire(ParkingRequest* request) {
+    if (request == nullptr) return false;
+
+    Entry* entry = getEntry(request->getRequestId());
+    if (entry == nullptr || entry->live.load(std::memory_order_relaxed) != request) {
+        return false;
+    }
+
+    RequestState state = request->getState();
+    if (state != RELEASED && state != CANCELLED) {
+        return false;
+    }
+
+    // Grow the chunk directory if needed, then the chunk itself
+    int chunk = archivedCount / ARCHIVE_CHUNK_SIZE;
+    if (chunk >= chunkCapacity) {
+        int newCapacity = chunkCapacity * 2;
+        ArchivedRequest** newChunks = new ArchivedRequest*[newCapacity];
+        for (int i = 0; i < newCapacity; i++) {
+            newChunks[i] = (i < chunkCapacity) ? archiveChunks[i] : nullptr;
+        }
+        delete[] archiveChunks;
+        archiveChunks = newChunks;
+        chunkCapacity = newCapacity;
+    }
+    if (archiveChunks[chunk] == nullptr) {
+        archiveChunks[chunk] = new ArchivedRequest[ARCHIVE_CHUNK_SIZE];
+    }
+
+    ArchivedRequest* record = archiveSlot(archivedCount);
+    record->requestId = request->getRequestId();
+    record->requestedZoneId = request->getRequestedZoneId();
+    record->allocatedSlotId = request->getAllocatedSlotId();
+    record->finalState = state;
+    record->crossZoneAllocation = request->isCrossZone();
+    record->requestTime = request->getRequestTime();
+    record->occupiedTime = request->getOccupiedTime();
+    record->releaseTime = request->getReleaseTime();
+    record->vehicle = request->getVehicleHandle();
+
+    entry->archiveIndex = archivedCount;
+    entry->live.store(nullptr, std::memory_order_release);
+    archivedCount++;
+    liveCount--;
+
+    freeList.add(request);
+    return true;
+}
+
+ParkingRequest* RequestTable::getLive(int requestId) const {
+    Entry* entry = getEntry(requestId);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    return entry->live.load(std::memory_order_acquire);
+}
+
+const ArchivedRequest* RequestTable::getArchived(int requestId) const {
+    Entry* entry = getEntry(requestId);
+    if (entry == nullptr || entry->archiveIndex < 0) {
+        return nullptr;
+    }
+    return archiveSlot(entry->archiveIndex);
+}
+
+bool RequestTable::contains(int requestId) const {
+    return getEntry(requestId) != nullptr;
+}
+
+int RequestTable::getNextRequestId() const {
+    return firstRequestId + entryCount.load(std::memory_order_acquire);
+}
+
+int RequestTable::getTotalCount() const {
+    return entryCount.load(std::memory_order_acquire);
+}
+
+int RequestTable::getLiveCount() const {
+    return liveCount;
+}
+
+int RequestTable::getArchivedCount() const {
+    return archivedCount;
+}
+
+int RequestTable::getRecycledCount() const {
+    return freeList.getSize();
+}
+
+void RequestTable::displayAll() const {
+    Entry** directory = entryChunks.load(std::memory_order_acquire);
+    int count = entryCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        const Entry& entry = directory[i / ENTRY_CHUNK_SIZE][i % ENTRY_CHUNK_SIZE];
+        ParkingRequest* live = entry.live.load(std::memory_order_acquire);
+        if (live != nullptr) {
+            live->displayRequestInfo();
+        } else {
+            archiveSlot(entry.archiveIndex)->displayRequestInfo(vehiclePool);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "include/ReservationCalendar.h"
+
+ReservationCalendar::ReservationCalendar(long long originTime, int seconds, int buckets)
+    : origin(originTime), bucketSeconds(seconds < 1 ? 1 : seconds),
+      bucketCount(buckets < 1 ? 1 : buckets) {
+    leafCount = 1;
+    while (leafCount < bucketCount) {
+        leafCount *= 2;
+    }
+    maxCount = new int[2 * leafCount];
+    pendingAdd = new int[2 * leafCount];
+    for (int i = 0; i < 2 * leafCount; i++) {
+        maxCount[i] = 0;
+        pendingAdd[i] = 0;
+    }
+}
+
+ReservationCalendar::~ReservationCalendar() {
+    delete[] maxCount;
+    delete[] pendingAdd;
+}
+
+void ReservationCalendar::add(int node, int nodeLow, int nodeHigh, int low, int high, int delta) {
+    if (high < nodeLow || nodeHigh < low) return;
+    if (low <= nodeLow && nodeHigh <= high) {
+        // Whole node covered: record the add here instead of in every leaf
+        maxCount[node] += delta;
+        pendingAdd[node] += delta;
+        return;
+    }
+
+    int middle = (nodeLow + nodeHigh) / 2;
+    add(2 * node, nodeLow, middle, low, high, delta);
+    add(2 * node + 1, middle + 1, nodeHigh, low, high, delta);
+    int left = maxCount[2 * node];
+    int right = maxCount[2 * node + 1];
+    maxCount[node] = (left > right ? left : right) + pendingAdd[node];
+}
+
+int ReservationCalendar::query(int node, int nodeLow, int nodeHigh, int low, int high) const {
+    if (high < nodeLow || nodeHigh < low) return 0;
+    if (low <= nodeLow && nodeHigh <= high) {
+        return maxCount[node];
+    }
+
+    // Adds recorded on this node apply to every bucket below it
+    int middle = (nodeLow + nodeHigh) / 2;
+    int left = query(2 * node, nodeLow, middle, low, high);
+    int right = query(2 * node + 1, middle + 1, nodeHigh, low, high);
+    return (left > right ? left : right) + pendingAdd[node];
+}
+
+bool ReservationCalendar::covers(long long start, long long end) const {
+    return start < end && start >= origin && end <= getHorizonEnd();
+}
+
+bool ReservationCalendar::addBooking(long long start, long long end, int delta) {
+    if (!covers(start, end)) return false;
+    int low = (int)((start - origin) / bucketSeconds);
+    int high = (int)((end - 1 - origin) / bucketSeconds);
+    add(1, 0, leafCount - 1, low, high, delta);
+    return true;
+}
+
+int ReservationCalendar::getMaxBooked(long long start, long long end) const {
+    if (start < origin) start = origin;
+    if (end > getHorizonEnd()) end = getHorizonEnd();
+    if (start >= end) return 0;
+    int low = (int)((start - origin) / bucketSeconds);
+    int high = (int)((end - 1 - origin) / bucketSeconds);
+    return query(1, 0, leafCount - 1, low, high);
+}
+
+long long ReservationCalendar::getOrigin() const {
+    return origin;
+}
+
+long long ReservationCalendar::getHorizonEnd() const {
+    return origin + (long long)bucketSeconds * bucketCount;
+}
+
+int ReservationCalendar::getBucketSeconds() const {
+    return bucketSeconds;
+}
+
+int ReservationCalendar::getBucketCount() const {
+    return bucketCount;
+}
@@ -1,71 +1,127 @@
 #include "include/RollbackManager.h"
 #include "include/ParkingSystem.h"
 #include <iostream>
-#include <cstring>
 #include <ctime>
 
-RollbackManager::RollbackManager(ParkingSystem* sys) : system(sys) {}
+RollbackManager::RollbackManager(ParkingSystem* sys) : nextSequence(0), depth(0), system(sys) {}
 
 RollbackManager::~RollbackManager() {}
 
-void RollbackManager::logAllocation(int slotId, const char* vehicleId, int prevState) {
+RollbackManager::LogStripe& RollbackManager::stripeFor(int requestId) {
+    return stripes[(unsigned int)requestId % LOG_STRIPES];
+}
+
+int RollbackManager::newestStripe() const {
+    int newest = -1;
+    long long newestSequence = -1;
+    for (int s = 0; s < LOG_STRIPES; s++) {
+        if (stripes[s].operations.isEmpty()) continue;
+        long long sequence = stripes[s].operations.peek().sequence;
+        if (sequence > newestSequence) {
+            newestSequence = sequence;
+            newest = s;
+        }
+    }
+    return newest;
+}
+
+void RollbackManager::logAllocation(const ParkingRequest* request, int prevState) {
     RollbackOperation op;
-    op.slotId = slotId;
+    op.slotId = request->getAllocatedSlotId();
+    op.slotCount = request->getSlotCount();
     op.previousAvailability = true;  // Slot was available before allocation
     op.previousRequestState = prevState;
+    op.vehicle = request->getVehicleHandle();
+    op.requestId = request->getRequestId();
     op.timestamp = time(nullptr);
     
-    if (vehicleId != nullptr) {
-        int len = strlen(vehicleId);
-        op.vehicleId = new char[len + 1];
-        strcpy(op.vehicleId, vehicleId);
+    // Numbered under the stripe lock, so every stripe stays sorted
+    LogStripe& stripe = stripeFor(op.requestId);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    op.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+    stripe.operations.push(op);
+    depth.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RollbackManager::logAllocationBatch(ParkingRequest* const* requests, int count, int prevState) {
+    if (count <= 0) return;
+    
+    // One sequence range and one timestamp for the whole batch, so a partial
+    // rollback undoes its tail. Every stripe is held (in index order) while
+    // the range is taken and pushed, which keeps each stripe sorted.
+    int perStripe[LOG_STRIPES] = {};
+    for (int i = 0; i < count; i++) {
+        perStripe[(unsigned int)requests[i]->getRequestId() % LOG_STRIPES]++;
+    }
+    for (int s = 0; s < LOG_STRIPES; s++) {
+        stripes[s].lock.lock();
+        stripes[s].operations.reserve(perStripe[s]);
     }
     
-    operationStack.push(op);
+    long long first = nextSequence.fetch_add(count, std::memory_order_relaxed);
+    RollbackOperation op;
+    op.previousAvailability = true;
+    op.previousRequestState = prevState;
+    op.timestamp = time(nullptr);
+    for (int i = 0; i < count; i++) {
+        op.slotId = requests[i]->getAllocatedSlotId();
+        op.slotCount = requests[i]->getSlotCount();
+        op.vehicle = requests[i]->getVehicleHandle();
+        op.requestId = requests[i]->getRequestId();
+        op.sequence = first + i;
+        stripeFor(op.requestId).operations.push(op);
+    }
+    depth.fetch_add(count, std::memory_order_relaxed);
+    
+    for (int s = LOG_STRIPES - 1; s >= 0; s--) {
+        stripes[s].lock.unlock();
+    }
 }
 
 bool RollbackManager::rollback(int k) {
-    if (k <= 0 || operationStack.isEmpty()) {
+    if (k <= 0 || depth.load() == 0) {
         return false;
     }
     
+    // Each allocation is detached from its request before the caller hands
+    // the freed slots on. One that has moved on (arrived, or already ended)
+    // is past undoing; its slot is no longer the allocation's to free.
     int rolledBack = 0;
-    for (int i = 0; i < k && !operationStack.isEmpty(); i++) {
-        RollbackOperation op = operationStack.pop();
-        
-        // Find and restore slot
-        ParkingSlot* slot = system->findSlotById(op.slotId);
-        if (slot != nullptr) {
-            slot->release();  // Free the slot
-        }
-        
-        // Find and restore request
-        if (op.vehicleId != nullptr) {
-            ParkingRequest* request = system->findRequestByVehicle(op.vehicleId);
-            if (request != nullptr) {
-                // Restore previous state
-                RequestState prevState = static_cast<RequestState>(op.previousRequestState);
-                request->setState(prevState);
-            }
+    int skipped = 0;
+    for (int i = 0; i < k; i++) {
+        int newest = newestStripe();
+        if (newest < 0) break;
+        RollbackOperation op = stripes[newest].operations.pop();
+        depth.fetch_sub(1, std::memory_order_relaxed);
+        if (system->undoAllocation(op.requestId, op.slotId)) {
+            rolledBack++;
+        } else {
+            skipped++;
         }
-        
-        rolledBack++;
     }
     
-    std::cout << "Rolled back " << rolledBack << " operation(s)" << std::endl;
+    std::cout << "Rolled back " << rolledBack << " operation(s)";
+    if (skipped > 0) {
+        std::cout << ", skipped " << skipped << " no longer ALLOCATED";
+    }
+    std::cout << std::endl;
     return true;
 }
 
 bool RollbackManager::canRollback() const {
-    return !operationStack.isEmpty();
+    return depth.load() > 0;
 }
 
 int RollbackManager::getRollbackDepth() const {
-    return operationStack.getSize();
+    return depth.load();
 }
 
 void RollbackManager::clearHistory() {
-    while (!operationStack.isEmpty()) {
-        operationStack.pop();
+    for (int s = 0; s < LOG_STRIPES; s++) {
+        std::lock_guard<std::mutex> guard(stripes[s].lock);
+        while (!stripes[s].operations.isEmpty()) {
+            stripes[s].operations.pop();
+        }
     }
+    depth.store(0);
 }
@@ -0,0 +1,140 @@
+#include "include/SlotDirectory.h"
+#include "include/Zone.h"
+#include <iostream>
+
+SlotDirectory::SlotDirectory() : entries(64), idCapacity(64), idCount(0), maxSlotId(0) {
+    idKeys = new int[idCapacity];
+    idHandles = new int[idCapacity];
+    for (int i = 0; i < idCapacity; i++) {
+        idKeys[i] = EMPTY_KEY;
+        idHandles[i] = -1;
+    }
+}
+
+SlotDirectory::~SlotDirectory() {
+    delete[] idKeys;
+    delete[] idHandles;
+}
+
+int SlotDirectory::probeIndex(int slotId) const {
+    // Fibonacci hashing spreads the clustered areaId * stride + i IDs
+    unsigned long long hash = (unsigned long long)(unsigned int)slotId * 11400714819323198485ULL;
+    int mask = idCapacity - 1;
+    int index = (int)(hash >> 32) & mask;
+    while (idKeys[index] != EMPTY_KEY && idKeys[index] != slotId) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void SlotDirectory::growIdTable() {
+    int oldCapacity = idCapacity;
+    int* oldKeys = idKeys;
+    int* oldHandles = idHandles;
+
+    idCapacity *= 2;
+    idKeys = new int[idCapacity];
+    idHandles = new int[idCapacity];
+    for (int i = 0; i < idCapacity; i++) {
+        idKeys[i] = EMPTY_KEY;
+        idHandles[i] = -1;
+    }
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldKeys[i] != EMPTY_KEY) {
+            int index = probeIndex(oldKeys[i]);
+            idKeys[index] = oldKeys[i];
+            idHandles[index] = oldHandles[i];
+        }
+    }
+
+    delete[] oldKeys;
+    delete[] oldHandles;
+}
+
+bool SlotDirectory::insertId(int slotId, int handle) {
+    // Keep load factor at or below 1/2 so probe chains stay short
+    if ((idCount + 1) * 2 > idCapacity) {
+        growIdTable();
+    }
+
+    int index = probeIndex(slotId);
+    if (idKeys[index] == slotId) {
+        return false;
+    }
+    idKeys[index] = slotId;
+    idHandles[index] = handle;
+    idCount++;
+    return true;
+}
+
+int SlotDirectory::registerSlot(ParkingSlot* slot, ParkingArea* area, Zone* zone) {
+    if (slot == nullptr) return -1;
+    if (slot->getSlotHandle() >= 0) return slot->getSlotHandle();
+
+    int handle = entries.getSize();
+    SlotDirectoryEntry entry;
+    entry.slot = slot;
+    entry.area = area;
+    entry.zone = zone;
+    entries.add(entry);
+    slot->setSlotHandle(handle);
+
+    int slotId = slot->getSlotId();
+    if (slotId == EMPTY_KEY || !insertId(slotId, handle)) {
+        int newId = maxSlotId + 1;
+        std::cout << "Warning: slot ID " << slotId << " in area " << slot->getAreaId()
+                  << " already in use; reassigned to " << newId << std::endl;
+        slot->setSlotId(newId);
+        insertId(newId, handle);
+        slotId = newId;
+    }
+    if (slotId > maxSlotId) {
+        maxSlotId = slotId;
+    }
+    return handle;
+}
+
+void SlotDirectory::registerArea(ParkingArea* area, Zone* zone) {
+    if (area == nullptr) return;
+    for (int i = 0; i < area->getTotalSlots(); i++) {
+        registerSlot(area->getSlotByIndex(i), area, zone);
+    }
+}
+
+int SlotDirectory::findHandle(int slotId) const {
+    if (slotId == EMPTY_KEY) return -1;
+    int index = probeIndex(slotId);
+    if (idKeys[index] == slotId) {
+        return idHandles[index];
+    }
+    return -1;
+}
+
+ParkingSlot* SlotDirectory::findSlotById(int slotId) {
+    return getSlot(findHandle(slotId));
+}
+
+ParkingSlot* SlotDirectory::getSlot(int handle) {
+    if (handle < 0 || handle >= entries.getSize()) return nullptr;
+    return entries[handle].slot;
+}
+
+ParkingArea* SlotDirectory::getArea(int handle) {
+    if (handle < 0 || handle >= entries.getSize()) return nullptr;
+    return entries[handle].area;
+}
+
+Zone* SlotDirectory::getZone(int handle) {
+    if (handle < 0 || handle >= entries.getSize()) return nullptr;
+    return entries[handle].zone;
+}
+
+const SlotDirectoryEntry* SlotDirectory::getEntry(int handle) const {
+    if (handle < 0 || handle >= entries.getSize()) return nullptr;
+    return &entries[handle];
+}
+
+int SlotDirectory::getSlotCount() const {
+    return entries.getSize();
+}
@@ -0,0 +1,298 @@
+#include "include/SlotKernels.h"
+#include "include/Bitmap.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SLOT_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define SLOT_KERNELS_X86 0
+#endif
+
+// GCC/Clang compile each SIMD kernel for its own target, so the rest of the
+// program needs no -mavx2 and still runs on CPUs without it
+#if defined(__GNUC__) || defined(__clang__)
+#define SLOT_KERNEL_TARGET(arch) __attribute__((target(arch)))
+#else
+#define SLOT_KERNEL_TARGET(arch)
+#endif
+
+// ---------------------------------------------------------------------------
+// Scalar reference kernels
+// ---------------------------------------------------------------------------
+
+static void countScalar(const unsigned char* statuses, int begin, int end, SlotStatusCounts& counts) {
+    for (int i = begin; i < end; i++) {
+        switch (statuses[i]) {
+            case SLOT_AVAILABLE:   counts.available++; break;
+            case SLOT_OCCUPIED:    counts.occupied++; break;
+            case SLOT_RESERVED:    counts.reserved++; break;
+            case SLOT_MAINTENANCE: counts.maintenance++; break;
+        }
+    }
+}
+
+static int findEqualScalar(const unsigned char* statuses, int begin, int end, unsigned char value) {
+    for (int i = begin; i < end; i++) {
+        if (statuses[i] == value) return i;
+    }
+    return -1;
+}
+
+static int findNotEqualScalar(const unsigned char* statuses, int begin, int end, unsigned char value) {
+    for (int i = begin; i < end; i++) {
+        if (statuses[i] != value) return i;
+    }
+    return -1;
+}
+
+#if SLOT_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE2 kernels (16 slots per step)
+// ---------------------------------------------------------------------------
+
+SLOT_KERNEL_TARGET("sse2")
+static int sumBytesSse2(__m128i bytes) {
+    __m128i sums = _mm_sad_epu8(bytes, _mm_setzero_si128());
+    return _mm_extract_epi16(sums, 0) + _mm_extract_epi16(sums, 4);
+}
+
+SLOT_KERNEL_TARGET("sse2")
+static void countSse2(const unsigned char* statuses, int count, SlotStatusCounts& counts) {
+    const __m128i available = _mm_set1_epi8((char)SLOT_AVAILABLE);
+    const __m128i occupied = _mm_set1_epi8((char)SLOT_OCCUPIED);
+    const __m128i reserved = _mm_set1_epi8((char)SLOT_RESERVED);
+
+    int i = 0;
+    int vectorEnd = count & ~15;
+    while (i < vectorEnd) {
+        // Byte lanes count matches by subtracting the all-ones compare result;
+        // flush before any lane can pass 255
+        __m128i accAvailable = _mm_setzero_si128();
+        __m128i accOccupied = _mm_setzero_si128();
+        __m128i accReserved = _mm_setzero_si128();
+        int blockEnd = i + 16 * 255;
+        if (blockEnd > vectorEnd) blockEnd = vectorEnd;
+
+        for (; i < blockEnd; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(statuses + i));
+            accAvailable = _mm_sub_epi8(accAvailable, _mm_cmpeq_epi8(v, available));
+            accOccupied = _mm_sub_epi8(accOccupied, _mm_cmpeq_epi8(v, occupied));
+            accReserved = _mm_sub_epi8(accReserved, _mm_cmpeq_epi8(v, reserved));
+        }
+
+        counts.available += sumBytesSse2(accAvailable);
+        counts.occupied += sumBytesSse2(accOccupied);
+        counts.reserved += sumBytesSse2(accReserved);
+    }
+    counts.maintenance += vectorEnd - (counts.available + counts.occupied + counts.reserved);
+
+    countScalar(statuses, vectorEnd, count, counts);
+}
+
+SLOT_KERNEL_TARGET("sse2")
+static int findEqualSse2(const unsigned char* statuses, int count, unsigned char value) {
+    const __m128i target = _mm_set1_epi8((char)value);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(statuses + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, target));
+        if (mask != 0) {
+            return i + Bitmap::countTrailingZeros(mask);
+        }
+    }
+    return findEqualScalar(statuses, i, count, value);
+}
+
+SLOT_KERNEL_TARGET("sse2")
+static int findNotEqualSse2(const unsigned char* statuses, int count, unsigned char value) {
+    const __m128i target = _mm_set1_epi8((char)value);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(statuses + i));
+        unsigned int mask = ~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, target)) & 0xFFFFu;
+        if (mask != 0) {
+            return i + Bitmap::countTrailingZeros(mask);
+        }
+    }
+    return findNotEqualScalar(statuses, i, count, value);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernels (32 slots per step)
+// ---------------------------------------------------------------------------
+
+SLOT_KERNEL_TARGET("avx2")
+static int sumBytesAvx2(__m256i bytes) {
+    __m256i sums = _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+    __m128i folded = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return _mm_extract_epi16(folded, 0) + _mm_extract_epi16(folded, 4);
+}
+
+SLOT_KERNEL_TARGET("avx2")
+static void countAvx2(const unsigned char* statuses, int count, SlotStatusCounts& counts) {
+    const __m256i available = _mm256_set1_epi8((char)SLOT_AVAILABLE);
+    const __m256i occupied = _mm256_set1_epi8((char)SLOT_OCCUPIED);
+    const __m256i reserved = _mm256_set1_epi8((char)SLOT_RESERVED);
+
+    int i = 0;
+    int vectorEnd = count & ~31;
+    while (i < vectorEnd) {
+        __m256i accAvailable = _mm256_setzero_si256();
+        __m256i accOccupied = _mm256_setzero_si256();
+        __m256i accReserved = _mm256_setzero_si256();
+        int blockEnd = i + 32 * 255;
+        if (blockEnd > vectorEnd) blockEnd = vectorEnd;
+
+        for (; i < blockEnd; i += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(statuses + i));
+            accAvailable = _mm256_sub_epi8(accAvailable, _mm256_cmpeq_epi8(v, available));
+            accOccupied = _mm256_sub_epi8(accOccupied, _mm256_cmpeq_epi8(v, occupied));
+            accReserved = _mm256_sub_epi8(accReserved, _mm256_cmpeq_epi8(v, reserved));
+        }
+
+        counts.available += sumBytesAvx2(accAvailable);
+        counts.occupied += sumBytesAvx2(accOccupied);
+        counts.reserved += sumBytesAvx2(accReserved);
+    }
+    counts.maintenance += vectorEnd - (counts.available + counts.occupied + counts.reserved);
+
+    countScalar(statuses, vectorEnd, count, counts);
+}
+
+SLOT_KERNEL_TARGET("avx2")
+static int findEqualAvx2(const unsigned char* statuses, int count, unsigned char value) {
+    const __m256i target = _mm256_set1_epi8((char)value);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(statuses + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target));
+        if (mask != 0) {
+            return i + Bitmap::countTrailingZeros(mask);
+        }
+    }
+    return findEqualScalar(statuses, i, count, value);
+}
+
+SLOT_KERNEL_TARGET("avx2")
+static int findNotEqualAvx2(const unsigned char* statuses, int count, unsigned char value) {
+    const __m256i target = _mm256_set1_epi8((char)value);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(statuses + i));
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target));
+        if (mask != 0) {
+            return i + Bitmap::countTrailingZeros(mask);
+        }
+    }
+    return findNotEqualScalar(statuses, i, count, value);
+}
+
+#endif // SLOT_KERNELS_X86
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+
+static KernelLevel detectBestLevel() {
+#if SLOT_KERNELS_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+    if (__builtin_cpu_supports("sse2")) return KERNEL_SSE2;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    // AVX2 also needs the OS to save YMM state (XCR0 bits 1 and 2)
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return KERNEL_AVX2;
+    }
+    if (sse2) return KERNEL_SSE2;
+#endif
+#endif
+    return KERNEL_SCALAR;
+}
+
+static KernelLevel resolveLevel(KernelLevel level) {
+    if (level == KERNEL_AUTO || !SlotKernels::isSupported(level)) {
+        return SlotKernels::getBestLevel();
+    }
+    return level;
+}
+
+KernelLevel SlotKernels::getBestLevel() {
+    // Detected once; CPU features cannot change while running
+    static const KernelLevel bestLevel = detectBestLevel();
+    return bestLevel;
+}
+
+bool SlotKernels::isSupported(KernelLevel level) {
+    switch (level) {
+        case KERNEL_AUTO:
+        case KERNEL_SCALAR:
+            return true;
+        case KERNEL_SSE2:
+            return getBestLevel() == KERNEL_SSE2 || getBestLevel() == KERNEL_AVX2;
+        case KERNEL_AVX2:
+            return getBestLevel() == KERNEL_AVX2;
+        default:
+            return false;
+    }
+}
+
+const char* SlotKernels::getLevelName(KernelLevel level) {
+    switch (level) {
+        case KERNEL_AUTO: return "AUTO";
+        case KERNEL_SCALAR: return "SCALAR";
+        case KERNEL_SSE2: return "SSE2";
+        case KERNEL_AVX2: return "AVX2";
+        default: return "UNKNOWN";
+    }
+}
+
+SlotStatusCounts SlotKernels::countStatuses(const unsigned char* statuses, int count, KernelLevel level) {
+    SlotStatusCounts counts;
+    if (statuses == nullptr || count <= 0) return counts;
+
+    switch (resolveLevel(level)) {
+#if SLOT_KERNELS_X86
+        case KERNEL_AVX2: countAvx2(statuses, count, counts); break;
+        case KERNEL_SSE2: countSse2(statuses, count, counts); break;
+#endif
+        default: countScalar(statuses, 0, count, counts); break;
+    }
+    return counts;
+}
+
+int SlotKernels::findFirstAvailable(const unsigned char* statuses, int count, KernelLevel level) {
+    if (statuses == nullptr || count <= 0) return -1;
+
+    switch (resolveLevel(level)) {
+#if SLOT_KERNELS_X86
+        case KERNEL_AVX2: return findEqualAvx2(statuses, count, SLOT_AVAILABLE);
+        case KERNEL_SSE2: return findEqualSse2(statuses, count, SLOT_AVAILABLE);
+#endif
+        default: return findEqualScalar(statuses, 0, count, SLOT_AVAILABLE);
+    }
+}
+
+int SlotKernels::findFirstNotMaintenance(const unsigned char* statuses, int count, KernelLevel level) {
+    if (statuses == nullptr || count <= 0) return -1;
+
+    switch (resolveLevel(level)) {
+#if SLOT_KERNELS_X86
+        case KERNEL_AVX2: return findNotEqualAvx2(statuses, count, SLOT_MAINTENANCE);
+        case KERNEL_SSE2: return findNotEqualSse2(statuses, count, SLOT_MAINTENANCE);
+#endif
+        default: return findNotEqualScalar(statuses, 0, count, SLOT_MAINTENANCE);
+    }
+}
@@ -0,0 +1,159 @@
+#include "include/SlotTable.h"
+#include "include/ParkingSlot.h"
+#include <cstring>
+#include <new>
+
+size_t SlotTable::alignUp(size_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+SlotTable::SlotTable(ParkingArea* owner, int area, int zone, int count, int firstSlotId)
+    : slotCount(count < 0 ? 0 : count), areaId(area), zoneId(zone), ownerArea(owner),
+      vehiclePool(nullptr) {
+
+    // Lay out every column in one block
+    size_t n = (size_t)slotCount;
+    size_t statusOffset = 0;
+    size_t attributeOffset = alignUp(statusOffset + n * sizeof(unsigned char));
+    size_t timeOffset = alignUp(attributeOffset + n * sizeof(unsigned char));
+    size_t vehicleOffset = alignUp(timeOffset + n * sizeof(long long));
+    size_t idOffset = alignUp(vehicleOffset + n * sizeof(VehicleHandle));
+    size_t handleOffset = alignUp(idOffset + n * sizeof(int));
+    size_t viewOffset = alignUp(handleOffset + n * sizeof(int));
+    arenaBytes = alignUp(viewOffset + n * sizeof(ParkingSlot));
+
+    // Over-allocate so the first column can start on a cache line
+    arena = new unsigned char[arenaBytes + COLUMN_ALIGNMENT];
+    unsigned char* base = (unsigned char*)alignUp((size_t)arena);
+
+    statuses = base + statusOffset;
+    attributes = base + attributeOffset;
+    allocationTimes = (long long*)(base + timeOffset);
+    vehicleHandles = (VehicleHandle*)(base + vehicleOffset);
+    slotIds = (int*)(base + idOffset);
+    slotHandles = (int*)(base + handleOffset);
+    views = (ParkingSlot*)(base + viewOffset);
+
+    memset(statuses, SLOT_AVAILABLE, n);
+    memset(attributes, 0, n);
+    for (int i = 0; i < slotCount; i++) {
+        allocationTimes[i] = 0;
+        vehicleHandles[i] = NO_VEHICLE;
+        slotIds[i] = firstSlotId + i;
+        slotHandles[i] = -1;
+        new (&views[i]) ParkingSlot(this, i);
+    }
+}
+
+SlotTable::~SlotTable() {
+    for (int i = 0; i < slotCount; i++) {
+        views[i].~ParkingSlot();
+    }
+    delete[] arena;
+}
+
+int SlotTable::getSlotCount() const {
+    return slotCount;
+}
+
+int SlotTable::getAreaId() const {
+    return areaId;
+}
+
+int SlotTable::getZoneId() const {
+    return zoneId;
+}
+
+ParkingArea* SlotTable::getOwnerArea() const {
+    return ownerArea;
+}
+
+size_t SlotTable::getArenaBytes() const {
+    return arenaBytes;
+}
+
+ParkingSlot* SlotTable::getView(int index) {
+    if (index < 0 || index >= slotCount) return nullptr;
+    return &views[index];
+}
+
+VehicleIdPool* SlotTable::getVehiclePool() const {
+    return vehiclePool;
+}
+
+void SlotTable::setVehiclePool(VehicleIdPool* pool) {
+    vehiclePool = pool;
+}
+
+SlotStatus SlotTable::getStatus(int index) const {
+    return (SlotStatus)statuses[index];
+}
+
+void SlotTable::setStatus(int index, SlotStatus status) {
+    statuses[index] = (unsigned char)status;
+}
+
+unsigned int SlotTable::getAttributes(int index) const {
+    return attributes[index];
+}
+
+void SlotTable::setAttributes(int index, unsigned int mask) {
+    attributes[index] = (unsigned char)mask;
+}
+
+long long SlotTable::getAllocationTime(int index) const {
+    return allocationTimes[index];
+}
+
+void SlotTable::setAllocationTime(int index, long long time) {
+    allocationTimes[index] = time;
+}
+
+VehicleHandle SlotTable::getVehicleHandle(int index) const {
+    return vehicleHandles[index];
+}
+
+void SlotTable::setVehicleHandle(int index, VehicleHandle vehicle) {
+    vehicleHandles[index] = vehicle;
+}
+
+const char* SlotTable::getVehicleId(int index) const {
+    if (vehiclePool == nullptr) return nullptr;
+    return vehiclePool->getString(vehicleHandles[index]);
+}
+
+int SlotTable::getSlotId(int index) const {
+    return slotIds[index];
+}
+
+void SlotTable::setSlotId(int index, int id) {
+    slotIds[index] = id;
+}
+
+int SlotTable::getSlotHandle(int index) const {
+    return slotHandles[index];
+}
+
+void SlotTable::setSlotHandle(int index, int handle) {
+    slotHandles[index] = handle;
+}
+
+const unsigned char* SlotTable::getStatusArray() const {
+    return statuses;
+}
+
+int SlotTable::countStatus(SlotStatus status) const {
+    return getStatusCounts().get(status);
+}
+
+SlotStatusCounts SlotTable::getStatusCounts(KernelLevel level) const {
+    return SlotKernels::countStatuses(statuses, slotCount, level);
+}
+
+int SlotTable::findFirstAvailable(KernelLevel level) const {
+    return SlotKernels::findFirstAvailable(statuses, slotCount, level);
+}
+
+int SlotTable::findFirstNotMaintenance(KernelLevel level) const {
+    return SlotKernels::findFirstNotMaintenance(statuses, slotCount, level);
+}
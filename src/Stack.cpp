@@ -28,6 +28,20 @@ void Stack::push(const RollbackOperation& operation) {
     data[++top] = operation;
 }
 
+void Stack::reserve(int additional) {
+    // Grow once up front so a batch of pushes never resizes midway
+    int needed = top + 1 + additional;
+    if (needed <= capacity) return;
+    
+    RollbackOperation* newData = new RollbackOperation[needed];
+    for (int i = 0; i <= top; i++) {
+        newData[i] = data[i];
+    }
+    delete[] data;
+    data = newData;
+    capacity = needed;
+}
+
 RollbackOperation Stack::pop() {
     if (isEmpty()) {
         throw std::underflow_error("Stack is empty");
@@ -0,0 +1,162 @@
+#include "include/TimingWheel.h"
+
+TimingWheel::TimingWheel(long long startTick)
+    : nodes(1024), freeHead(-1), activeCount(0), currentTick(startTick) {
+    for (int i = 0; i < LEVELS * BUCKETS; i++) {
+        heads[i] = -1;
+    }
+}
+
+TimingWheel::~TimingWheel() {}
+
+int TimingWheel::allocateNode() {
+    if (freeHead != -1) {
+        int node = freeHead;
+        freeHead = nodes[node].next;
+        return node;
+    }
+    nodes.add(TimerNode());
+    return nodes.getSize() - 1;
+}
+
+void TimingWheel::freeNode(int node) {
+    TimerNode& timer = nodes[node];
+    timer.bucket = -1;
+    timer.prev = -1;
+    timer.generation = (timer.generation + 1) & 0x7FFFFFFF;    // Stales old handles
+    timer.next = freeHead;
+    freeHead = node;
+}
+
+void TimingWheel::link(int node) {
+    TimerNode& timer = nodes[node];
+    long long delta = timer.deadline - currentTick;
+
+    // Lowest level whose span reaches the deadline
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1LL << (BUCKET_BITS * (level + 1)))) {
+        level++;
+    }
+    int bucket = level * BUCKETS + (int)((timer.deadline >> (BUCKET_BITS * level)) & BUCKET_MASK);
+
+    timer.bucket = bucket;
+    timer.prev = -1;
+    timer.next = heads[bucket];
+    if (heads[bucket] != -1) {
+        nodes[heads[bucket]].prev = node;
+    }
+    heads[bucket] = node;
+}
+
+void TimingWheel::unlink(int node) {
+    TimerNode& timer = nodes[node];
+    if (timer.prev != -1) {
+        nodes[timer.prev].next = timer.next;
+    } else {
+        heads[timer.bucket] = timer.next;
+    }
+    if (timer.next != -1) {
+        nodes[timer.next].prev = timer.prev;
+    }
+}
+
+void TimingWheel::cascade(int level) {
+    int bucket = level * BUCKETS + (int)((currentTick >> (BUCKET_BITS * level)) & BUCKET_MASK);
+    int node = heads[bucket];
+    heads[bucket] = -1;
+
+    // Every timer here is due within this level's current slot, so it lands lower
+    while (node != -1) {
+        int next = nodes[node].next;
+        link(node);
+        node = next;
+    }
+}
+
+int TimingWheel::resolve(TimerHandle handle) const {
+    if (handle < 0) return -1;
+    int node = (int)(handle & 0xFFFFFFFFLL);
+    unsigned int generation = (unsigned int)(handle >> 32);
+    if (node >= nodes.getSize()) return -1;
+    const TimerNode& timer = nodes[node];
+    if (timer.bucket == -1 || timer.generation != generation) return -1;
+    return node;
+}
+
+TimerHandle TimingWheel::schedule(long long deadline, int payload) {
+    // Past deadlines fire on the next tick; the top level spans 2^32 ticks
+    long long latest = currentTick + (1LL << (BUCKET_BITS * LEVELS)) - 1;
+    if (deadline <= currentTick) deadline = currentTick + 1;
+    if (deadline > latest) deadline = latest;
+
+    int node = allocateNode();
+    nodes[node].deadline = deadline;
+    nodes[node].payload = payload;
+    link(node);
+    activeCount++;
+    return ((TimerHandle)nodes[node].generation << 32) | (TimerHandle)node;
+}
+
+bool TimingWheel::cancel(TimerHandle handle) {
+    int node = resolve(handle);
+    if (node == -1) return false;
+    unlink(node);
+    freeNode(node);
+    activeCount--;
+    return true;
+}
+
+bool TimingWheel::isPending(TimerHandle handle) const {
+    return resolve(handle) != -1;
+}
+
+int TimingWheel::advance(long long now, DynamicArray<ExpiredTimer>& expired) {
+    int fired = 0;
+    while (currentTick < now) {
+        if (activeCount == 0) {
+            // Nothing to cascade or fire: jump straight to now
+            currentTick = now;
+            break;
+        }
+        currentTick++;
+
+        // A level wraps when every bit below it is zero; cascade top-down so a
+        // timer moved out of level 2 can continue into level 0 on the same tick
+        int top = 0;
+        while (top < LEVELS - 1 &&
+               ((currentTick >> (BUCKET_BITS * top)) & BUCKET_MASK) == 0) {
+            top++;
+        }
+        for (int level = top; level >= 1; level--) {
+            cascade(level);
+        }
+
+        int bucket = (int)(currentTick & BUCKET_MASK);
+        int node = heads[bucket];
+        heads[bucket] = -1;
+        while (node != -1) {
+            int next = nodes[node].next;
+            ExpiredTimer timer;
+            timer.handle = ((TimerHandle)nodes[node].generation << 32) | (TimerHandle)node;
+            timer.payload = nodes[node].payload;
+            expired.add(timer);
+            freeNode(node);
+            activeCount--;
+            fired++;
+            node = next;
+        }
+    }
+    return fired;
+}
+
+long long TimingWheel::getCurrentTick() const {
+    return currentTick;
+}
+
+int TimingWheel::getActiveCount() const {
+    return activeCount;
+}
+
+int TimingWheel::getNodeCapacity() const {
+    return nodes.getSize();
+}
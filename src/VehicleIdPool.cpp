@@ -0,0 +1,142 @@
+#include "include/VehicleIdPool.h"
+#include <cstring>
+
+VehicleIdPool::VehicleIdPool()
+    : chunkCount(0), chunkCapacity(8), chunkUsed(CHUNK_BYTES), bytesUsed(0),
+      strings(256), hashes(256), tableCapacity(256) {
+    chunks = new char*[chunkCapacity];
+
+    table = new VehicleHandle[tableCapacity];
+    for (int i = 0; i < tableCapacity; i++) {
+        table[i] = NO_VEHICLE;
+    }
+
+    // Reserve handle 0 for NO_VEHICLE
+    strings.add(nullptr);
+    hashes.add(0);
+}
+
+VehicleIdPool::~VehicleIdPool() {
+    for (int i = 0; i < chunkCount; i++) {
+        delete[] chunks[i];
+    }
+    delete[] chunks;
+    delete[] table;
+}
+
+unsigned int VehicleIdPool::hashPlate(const char* vehicleId) {
+    // FNV-1a
+    unsigned int hash = 2166136261u;
+    for (const char* p = vehicleId; *p != '\0'; p++) {
+        hash ^= (unsigned char)(*p);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int VehicleIdPool::findSlot(const char* vehicleId, unsigned int hash) const {
+    int mask = tableCapacity - 1;
+    int index = (int)(hash & (unsigned int)mask);
+    while (table[index] != NO_VEHICLE) {
+        VehicleHandle handle = table[index];
+        if (hashes[handle] == hash && strcmp(strings[handle], vehicleId) == 0) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+const char* VehicleIdPool::storeString(const char* vehicleId, int length) {
+    int needed = length + 1;
+
+    if (chunkUsed + needed > CHUNK_BYTES || chunkCount == 0) {
+        if (chunkCount >= chunkCapacity) {
+            int newCapacity = chunkCapacity * 2;
+            char** newChunks = new char*[newCapacity];
+            for (int i = 0; i < chunkCount; i++) {
+                newChunks[i] = chunks[i];
+            }
+            delete[] chunks;
+            chunks = newChunks;
+            chunkCapacity = newCapacity;
+        }
+        // Oversized plates get a chunk of their own
+        int chunkSize = (needed > CHUNK_BYTES) ? needed : CHUNK_BYTES;
+        chunks[chunkCount++] = new char[chunkSize];
+        chunkUsed = 0;
+    }
+
+    char* stored = chunks[chunkCount - 1] + chunkUsed;
+    memcpy(stored, vehicleId, needed);
+    chunkUsed += needed;
+    bytesUsed += needed;
+    return stored;
+}
+
+void VehicleIdPool::growTable() {
+    VehicleHandle* oldTable = table;
+    int oldCapacity = tableCapacity;
+
+    tableCapacity *= 2;
+    table = new VehicleHandle[tableCapacity];
+    for (int i = 0; i < tableCapacity; i++) {
+        table[i] = NO_VEHICLE;
+    }
+
+    int mask = tableCapacity - 1;
+    for (int i = 0; i < oldCapacity; i++) {
+        VehicleHandle handle = oldTable[i];
+        if (handle != NO_VEHICLE) {
+            int index = (int)(hashes[handle] & (unsigned int)mask);
+            while (table[index] != NO_VEHICLE) {
+                index = (index + 1) & mask;
+            }
+            table[index] = handle;
+        }
+    }
+
+    delete[] oldTable;
+}
+
+VehicleHandle VehicleIdPool::intern(const char* vehicleId) {
+    if (vehicleId == nullptr) return NO_VEHICLE;
+
+    unsigned int hash = hashPlate(vehicleId);
+    int index = findSlot(vehicleId, hash);
+    if (table[index] != NO_VEHICLE) {
+        return table[index];
+    }
+
+    // New plate: keep load factor below 1/2, then store it once
+    if ((strings.getSize() + 1) * 2 > tableCapacity) {
+        growTable();
+        index = findSlot(vehicleId, hash);
+    }
+
+    VehicleHandle handle = (VehicleHandle)strings.getSize();
+    strings.add(storeString(vehicleId, strlen(vehicleId)));
+    hashes.add(hash);
+    table[index] = handle;
+    return handle;
+}
+
+VehicleHandle VehicleIdPool::find(const char* vehicleId) const {
+    if (vehicleId == nullptr) return NO_VEHICLE;
+    return table[findSlot(vehicleId, hashPlate(vehicleId))];
+}
+
+const char* VehicleIdPool::getString(VehicleHandle handle) const {
+    if (handle == NO_VEHICLE || handle >= (VehicleHandle)strings.getSize()) {
+        return nullptr;
+    }
+    return strings[handle];
+}
+
+int VehicleIdPool::getSize() const {
+    return strings.getSize() - 1;
+}
+
+size_t VehicleIdPool::getBytesUsed() const {
+    return bytesUsed;
+}
@@ -0,0 +1,154 @@
+#include "include/VehicleIndex.h"
+#include "include/ParkingRequest.h"
+
+VehicleIndex::VehicleIndex(int initialCapacity) : count(0), vehicleCount(0) {
+    capacity = 16;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    buckets = new VehicleIndexBucket[capacity];
+}
+
+VehicleIndex::~VehicleIndex() {
+    delete[] buckets;
+}
+
+int VehicleIndex::idealBucket(VehicleHandle vehicle) const {
+    // Handles are dense; Fibonacci hashing spreads consecutive ones apart
+    unsigned int hash = vehicle * 2654435769u;
+    return (int)((hash ^ (hash >> 16)) & (unsigned int)(capacity - 1));
+}
+
+int VehicleIndex::findRequestBucket(const ParkingRequest* request) const {
+    int mask = capacity - 1;
+    int index = idealBucket(request->getVehicleHandle());
+    while (buckets[index].request != nullptr) {
+        if (buckets[index].request == request) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return -1;
+}
+
+int VehicleIndex::countVehicle(VehicleHandle vehicle) const {
+    // Every entry of a plate lies in the cluster after its ideal bucket
+    int mask = capacity - 1;
+    int found = 0;
+    for (int index = idealBucket(vehicle); buckets[index].request != nullptr; index = (index + 1) & mask) {
+        if (buckets[index].vehicle == vehicle) found++;
+    }
+    return found;
+}
+
+void VehicleIndex::grow() {
+    VehicleIndexBucket* oldBuckets = buckets;
+    int oldCapacity = capacity;
+
+    capacity *= 2;
+    buckets = new VehicleIndexBucket[capacity];
+
+    int mask = capacity - 1;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldBuckets[i].request != nullptr) {
+            int index = idealBucket(oldBuckets[i].vehicle);
+            while (buckets[index].request != nullptr) {
+                index = (index + 1) & mask;
+            }
+            buckets[index] = oldBuckets[i];
+        }
+    }
+
+    delete[] oldBuckets;
+}
+
+void VehicleIndex::insert(ParkingRequest* request) {
+    if (request == nullptr) return;
+
+    // Keep load factor below 3/4
+    if ((count + 1) * 4 > capacity * 3) {
+        grow();
+    }
+
+    if (findRequestBucket(request) != -1) return;
+
+    // A second live request for the plate gets its own bucket; the older one stays indexed
+    VehicleHandle vehicle = request->getVehicleHandle();
+    if (countVehicle(vehicle) == 0) {
+        vehicleCount++;
+    }
+    int mask = capacity - 1;
+    int index = idealBucket(vehicle);
+    while (buckets[index].request != nullptr) {
+        index = (index + 1) & mask;
+    }
+    buckets[index].vehicle = vehicle;
+    buckets[index].request = request;
+    count++;
+}
+
+bool VehicleIndex::remove(ParkingRequest* request) {
+    if (request == nullptr) return false;
+
+    // Only this request's own bucket is dropped
+    int index = findRequestBucket(request);
+    if (index == -1) {
+        return false;
+    }
+
+    // Backward-shift deletion: pull later entries of the cluster into the gap
+    int mask = capacity - 1;
+    int gap = index;
+    int next = (gap + 1) & mask;
+    while (buckets[next].request != nullptr) {
+        int ideal = idealBucket(buckets[next].vehicle);
+        // Move if the entry's ideal bucket is not cyclically within (gap, next]
+        bool canMove = (gap <= next) ? (ideal <= gap || ideal > next)
+                                     : (ideal <= gap && ideal > next);
+        if (canMove) {
+            buckets[gap] = buckets[next];
+            gap = next;
+        }
+        next = (next + 1) & mask;
+    }
+    buckets[gap].vehicle = NO_VEHICLE;
+    buckets[gap].request = nullptr;
+    count--;
+    if (countVehicle(request->getVehicleHandle()) == 0) {
+        vehicleCount--;
+    }
+    return true;
+}
+
+void VehicleIndex::clear() {
+    for (int i = 0; i < capacity; i++) {
+        buckets[i].vehicle = NO_VEHICLE;
+        buckets[i].request = nullptr;
+    }
+    count = 0;
+    vehicleCount = 0;
+}
+
+ParkingRequest* VehicleIndex::find(VehicleHandle vehicle) const {
+    if (vehicle == NO_VEHICLE) return nullptr;
+
+    // Request IDs only grow, so the highest one is the newest
+    int mask = capacity - 1;
+    ParkingRequest* newest = nullptr;
+    for (int index = idealBucket(vehicle); buckets[index].request != nullptr; index = (index + 1) & mask) {
+        ParkingRequest* request = buckets[index].request;
+        if (buckets[index].vehicle == vehicle &&
+            (newest == nullptr || request->getRequestId() > newest->getRequestId())) {
+            newest = request;
+        }
+    }
+    return newest;
+}
+
+int VehicleIndex::getSize() const {
+    return vehicleCount;
+}
+
+int VehicleIndex::getRequestCount() const {
+    return count;
+}
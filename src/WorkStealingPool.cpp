@@ -0,0 +1,166 @@
+#include "include/WorkStealingPool.h"
+
+WorkStealingPool::WorkerDeque::WorkerDeque() : capacity(64), top(0), bottom(0) {
+    tasks = new PoolTask[capacity];
+}
+
+WorkStealingPool::WorkerDeque::~WorkerDeque() {
+    delete[] tasks;
+}
+
+void WorkStealingPool::WorkerDeque::pushBottom(const PoolTask& task) {
+    if (bottom - top == capacity) {
+        PoolTask* grown = new PoolTask[capacity * 2];
+        for (int i = top; i < bottom; i++) {
+            grown[i - top] = tasks[i % capacity];
+        }
+        delete[] tasks;
+        tasks = grown;
+        bottom -= top;
+        top = 0;
+        capacity *= 2;
+    }
+    tasks[bottom % capacity] = task;
+    bottom++;
+}
+
+bool WorkStealingPool::WorkerDeque::popBottom(PoolTask& task) {
+    if (bottom == top) return false;
+    bottom--;
+    task = tasks[bottom % capacity];
+    if (top == bottom) {
+        top = 0;
+        bottom = 0;
+    }
+    return true;
+}
+
+bool WorkStealingPool::WorkerDeque::stealTop(PoolTask& task) {
+    if (bottom == top) return false;
+    task = tasks[top % capacity];
+    top++;
+    if (top == bottom) {
+        top = 0;
+        bottom = 0;
+    }
+    return true;
+}
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : workerCount(threads < 1 ? 1 : threads), stopping(false), queuedTasks(0),
+      pendingTasks(0), nextDeque(0), executedCount(0), stealCount(0) {
+    deques = new WorkerDeque[workerCount];
+    workers = new std::thread[workerCount];
+    for (int i = 0; i < workerCount; i++) {
+        workers[i] = std::thread(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping.store(true);
+    }
+    workAvailable.notify_all();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+    delete[] workers;
+    delete[] deques;
+}
+
+void WorkStealingPool::enqueue(int deque, const PoolTask& task) {
+    pendingTasks.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> guard(deques[deque].lock);
+        deques[deque].pushBottom(task);
+        queuedTasks.fetch_add(1);
+    }
+
+    // Taking sleepLock orders this push against a worker about to sleep
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::submit(PoolTaskFunction run, void* context) {
+    PoolTask task;
+    task.run = run;
+    task.context = context;
+    enqueue((int)(nextDeque.fetch_add(1) % (unsigned int)workerCount), task);
+}
+
+void WorkStealingPool::spawn(int worker, PoolTaskFunction run, void* context) {
+    if (worker < 0 || worker >= workerCount) {
+        submit(run, context);
+        return;
+    }
+    PoolTask task;
+    task.run = run;
+    task.context = context;
+    enqueue(worker, task);
+}
+
+bool WorkStealingPool::findTask(int worker, PoolTask& task) {
+    {
+        std::lock_guard<std::mutex> guard(deques[worker].lock);
+        if (deques[worker].popBottom(task)) {
+            queuedTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Own deque empty: steal the oldest task from the next busy worker
+    for (int offset = 1; offset < workerCount; offset++) {
+        int victim = (worker + offset) % workerCount;
+        std::lock_guard<std::mutex> guard(deques[victim].lock);
+        if (deques[victim].stealTop(task)) {
+            queuedTasks.fetch_sub(1);
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    PoolTask task;
+    while (true) {
+        if (findTask(worker, task)) {
+            task.run(task.context, this, worker);
+            executedCount.fetch_add(1, std::memory_order_relaxed);
+            if (pendingTasks.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                allIdle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        while (queuedTasks.load() == 0 && !stopping.load()) {
+            workAvailable.wait(guard);
+        }
+        if (stopping.load() && queuedTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::waitIdle() {
+    std::unique_lock<std::mutex> guard(sleepLock);
+    while (pendingTasks.load() != 0) {
+        allIdle.wait(guard);
+    }
+}
+
+int WorkStealingPool::getWorkerCount() const {
+    return workerCount;
+}
+
+long long WorkStealingPool::getExecutedCount() const {
+    return executedCount.load();
+}
+
+long long WorkStealingPool::getStealCount() const {
+    return stealCount.load();
+}
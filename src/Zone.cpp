@@ -2,10 +2,19 @@
 #include <iostream>
 #include <cstring>
 
-Zone::Zone(int id, const char* name) : zoneId(id) {
+Zone::Zone(int id, const char* name) 
+    : zoneId(id), areasWithCapacity(0), searchMode(SEARCH_BITMAP), directory(nullptr),
+      vehiclePool(nullptr), graph(nullptr), areaCursor(-1), freeEpoch(1) {
     int len = strlen(name);
     zoneName = new char[len + 1];
     strcpy(zoneName, name);
+    for (int c = 0; c < REQUEST_CLASS_COUNT; c++) {
+        classReserve[c] = 0;
+        classHeld[c].store(0);
+    }
+    for (int m = 0; m < (1 << SLOT_ATTRIBUTE_COUNT); m++) {
+        missCache[m].store(0);
+    }
 }
 
 Zone::~Zone() {
@@ -29,30 +38,43 @@ int Zone::getAreaCount() const {
 }
 
 int Zone::getTotalSlots() const {
-    int total = 0;
-    for (int i = 0; i < areas.getSize(); i++) {
-        total += areas[i]->getTotalSlots();
-    }
-    return total;
+    return occupancy.getTotalSlots();
 }
 
 int Zone::getOccupiedSlots() const {
-    int occupied = 0;
-    for (int i = 0; i < areas.getSize(); i++) {
-        occupied += areas[i]->getOccupiedSlots();
-    }
-    return occupied;
+    return occupancy.getUnavailableSlots();
 }
 
 float Zone::getUtilization() const {
-    int total = getTotalSlots();
-    if (total == 0) return 0.0f;
-    return (float)getOccupiedSlots() / total;
+    return occupancy.getUtilization();
+}
+
+OccupancyCounter* Zone::getOccupancy() {
+    return &occupancy;
+}
+
+SlotStatusCounts Zone::getStatusCounts(KernelLevel level) const {
+    SlotStatusCounts totals;
+    for (int i = 0; i < areas.getSize(); i++) {
+        SlotStatusCounts counts = areas[i]->getStatusCounts(level);
+        totals.available += counts.available;
+        totals.occupied += counts.occupied;
+        totals.reserved += counts.reserved;
+        totals.maintenance += counts.maintenance;
+    }
+    return totals;
 }
 
 void Zone::addParkingArea(ParkingArea* area) {
     if (area != nullptr) {
+        int index = areas.getSize();
         areas.add(area);
+        areasWithCapacity.resize(index + 1);
+        areasWithCapacity.assign(index, area->hasAvailableSlot());
+        area->attachToZone(this, index);
+        area->getOccupancy()->attachTo(&occupancy);
+        registerArea(area);
+        invalidateMisses();
     }
 }
 
@@ -72,14 +94,67 @@ ParkingArea* Zone::getAreaByIndex(int index) {
     return nullptr;
 }
 
-void Zone::addAdjacentZone(int zoneId) {
-    // Check if already exists
+void Zone::onAreaCapacityChanged(int areaIndex, bool hasCapacity) {
+    areasWithCapacity.assign(areaIndex, hasCapacity);
+}
+
+void Zone::registerArea(ParkingArea* area) {
+    if (vehiclePool != nullptr) {
+        area->getSlotTable()->setVehiclePool(vehiclePool);
+    }
+    if (directory != nullptr) {
+        directory->registerArea(area, this);
+    }
+}
+
+void Zone::attachToSystem(SlotDirectory* slotDirectory, VehicleIdPool* pool,
+                          OccupancyCounter* cityOccupancy, ZoneGraph* zoneGraph) {
+    directory = slotDirectory;
+    vehiclePool = pool;
+    graph = zoneGraph;
+    occupancy.attachTo(cityOccupancy);
+    for (int i = 0; i < areas.getSize(); i++) {
+        registerArea(areas[i]);
+    }
+}
+
+int Zone::getAreasWithCapacityCount() const {
+    return areasWithCapacity.count();
+}
+
+int Zone::findNextAreaWithCapacity(int fromIndex) const {
+    return areasWithCapacity.findNextSet(fromIndex);
+}
+
+int Zone::getAreaCursor() const {
+    return areaCursor;
+}
+
+void Zone::setAreaCursor(int index) {
+    areaCursor = index;
+}
+
+void Zone::addAdjacentZone(int zoneId, int weight) {
+    // Check if already exists (re-adding updates the weight)
     for (int i = 0; i < adjacentZoneIds.getSize(); i++) {
         if (adjacentZoneIds[i] == zoneId) {
+            if (adjacentZoneWeights[i] != weight) {
+                adjacentZoneWeights[i] = weight;
+                if (graph != nullptr) graph->invalidate();
+            }
             return;
         }
     }
     adjacentZoneIds.add(zoneId);
+    adjacentZoneWeights.add(weight);
+    if (graph != nullptr) graph->invalidate();
+}
+
+int Zone::getAdjacentZoneWeight(int index) const {
+    if (index >= 0 && index < adjacentZoneWeights.getSize()) {
+        return adjacentZoneWeights[index];
+    }
+    return -1;
 }
 
 bool Zone::isAdjacentTo(int zoneId) const {
@@ -102,7 +177,28 @@ int Zone::getAdjacentZone(int index) const {
     return -1;
 }
 
-ParkingSlot* Zone::findAvailableSlot() {
+ParkingSlot* Zone::findAvailableSlot(unsigned int required) {
+    if (required != 0) {
+        // Areas with capacity only; each intersects its free and attribute bitmaps
+        for (int index = areasWithCapacity.findFirstSet(); index >= 0;
+             index = areasWithCapacity.findNextSet(index + 1)) {
+            ParkingSlot* slot = areas[index]->findFirstAvailableSlotWith(required);
+            if (slot != nullptr) {
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+    
+    if (searchMode == SEARCH_BITMAP) {
+        // Jump straight to the first area with capacity; full areas are never probed
+        int index = areasWithCapacity.findFirstSet();
+        if (index < 0) {
+            return nullptr;
+        }
+        return areas[index]->findFirstAvailableSlot();
+    }
+    
     for (int i = 0; i < areas.getSize(); i++) {
         ParkingSlot* slot = areas[i]->findFirstAvailableSlot();
         if (slot != nullptr) {
@@ -112,6 +208,128 @@ ParkingSlot* Zone::findAvailableSlot() {
     return nullptr;
 }
 
+int Zone::collectAvailableSlots(ParkingSlot** out, int maxCount, unsigned int required) {
+    // One pass over the area summary and each area's free bitmap
+    int found = 0;
+    for (int index = areasWithCapacity.findFirstSet(); index >= 0 && found < maxCount;
+         index = areasWithCapacity.findNextSet(index + 1)) {
+        found += areas[index]->collectAvailableSlots(out + found, maxCount - found, required);
+    }
+    return found;
+}
+
+int Zone::countAvailableSlots(unsigned int required) const {
+    if (required == 0) return occupancy.getAvailableSlots();
+    int count = 0;
+    for (int index = areasWithCapacity.findFirstSet(); index >= 0;
+         index = areasWithCapacity.findNextSet(index + 1)) {
+        count += areas[index]->countAvailableSlots(required);
+    }
+    return count;
+}
+
+ParkingSlot* Zone::findAvailableRun(int length, unsigned int required) {
+    if (length <= 1) {
+        return findAvailableSlot(required);
+    }
+    
+    // Areas with fewer free slots than the run are skipped on their counter alone
+    for (int index = areasWithCapacity.findFirstSet(); index >= 0;
+         index = areasWithCapacity.findNextSet(index + 1)) {
+        ParkingArea* area = areas[index];
+        if (area->getAvailableSlots() < length) continue;
+        int first = area->findFreeRun(length, required);
+        if (first >= 0) {
+            return area->getSlotByIndex(first);
+        }
+    }
+    return nullptr;
+}
+
+void Zone::setSlotSearchMode(SlotSearchMode mode) {
+    searchMode = mode;
+    for (int i = 0; i < areas.getSize(); i++) {
+        areas[i]->setSearchMode(mode);
+    }
+}
+
+void Zone::setReservedCapacity(RequestClass requestClass, int slots) {
+    classReserve[requestClass] = slots < 0 ? 0 : slots;
+}
+
+int Zone::getReservedCapacity(RequestClass requestClass) const {
+    return classReserve[requestClass];
+}
+
+int Zone::getClassHeld(RequestClass requestClass) const {
+    return classHeld[requestClass].load(std::memory_order_relaxed);
+}
+
+bool Zone::admits(RequestClass requestClass, int heldBack) const {
+    return getAdmissibleSlots(requestClass, heldBack) > 0;
+}
+
+int Zone::getAdmissibleSlots(RequestClass requestClass, int heldBack) const {
+    // Reserves of higher classes stay free until those classes fill them
+    int blocked = 0;
+    for (int c = requestClass + 1; c < REQUEST_CLASS_COUNT; c++) {
+        int unused = classReserve[c] - classHeld[c].load(std::memory_order_relaxed);
+        if (unused > 0) blocked += unused;
+    }
+    int admissible = occupancy.getAvailableSlots() - blocked - heldBack;
+    return admissible > 0 ? admissible : 0;
+}
+
+int Zone::getBookableSlots() const {
+    // Advance bookings are standard-class: they may not sell a higher class's reserve
+    int bookable = occupancy.getTotalSlots() - occupancy.getCount(SLOT_MAINTENANCE);
+    for (int c = CLASS_STANDARD + 1; c < REQUEST_CLASS_COUNT; c++) {
+        bookable -= classReserve[c];
+    }
+    return bookable > 0 ? bookable : 0;
+}
+
+void Zone::chargeClass(RequestClass requestClass, int slots) {
+    classHeld[requestClass].fetch_add(slots, std::memory_order_relaxed);
+}
+
+void Zone::refundClass(RequestClass requestClass, int slots) {
+    classHeld[requestClass].fetch_sub(slots, std::memory_order_relaxed);
+}
+
+bool Zone::isKnownMiss(unsigned int required, int length) const {
+    if (required >> SLOT_ATTRIBUTE_COUNT) return false;    // Unknown attribute: never cached
+    long long entry = missCache[required].load(std::memory_order_relaxed);
+    if ((entry >> 16) != freeEpoch.load(std::memory_order_relaxed)) return false;
+    // No room for a run means no room for any longer one
+    return (entry & 0xFFFF) <= length;
+}
+
+void Zone::recordMiss(unsigned int required, int length) {
+    if (required >> SLOT_ATTRIBUTE_COUNT || length < 1) return;
+    if (length > 0xFFFF) length = 0xFFFF;
+    long long epoch = freeEpoch.load(std::memory_order_relaxed);
+    long long entry = missCache[required].load(std::memory_order_relaxed);
+    if ((entry >> 16) == epoch && (entry & 0xFFFF) <= length) return;
+    missCache[required].store(epoch << 16 | length, std::memory_order_relaxed);
+}
+
+void Zone::invalidateMisses() {
+    freeEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+long long Zone::getFreeEpoch() const {
+    return freeEpoch.load(std::memory_order_relaxed);
+}
+
+void Zone::lock() {
+    shardLock.lock();
+}
+
+void Zone::unlock() {
+    shardLock.unlock();
+}
+
 void Zone::displayZoneInfo() const {
     std::cout << "\n=== Zone: " << zoneName << " (ID: " << zoneId << ") ===" << std::endl;
     std::cout << "Total Slots: " << getTotalSlots() << std::endl;
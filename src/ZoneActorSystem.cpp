@@ -0,0 +1,248 @@
+#include "include/ZoneActorSystem.h"
+#include "include/ParkingSystem.h"
+
+ZoneActorSystem::ZoneActor::ZoneActor()
+    : zone(nullptr), mailbox(nullptr), forwarded(0), sameZone(0),
+      crossZone(0), failed(0), released(0) {}
+
+ZoneActorSystem::ZoneActorSystem(ParkingSystem* parkingSystem, int capacity)
+    : system(parkingSystem), mailboxCapacity(capacity < 2 ? 2 : capacity),
+      running(false), inFlight(0) {
+    ZoneGraph* graph = system->getZoneGraph();
+    actorCount = graph->getZoneCount();
+    actors = new ZoneActor[actorCount > 0 ? actorCount : 1];
+    for (int i = 0; i < actorCount; i++) {
+        actors[i].zone = graph->getZone(i);
+        actors[i].mailbox = new MpscRing<ZoneMessage>(mailboxCapacity);
+    }
+}
+
+ZoneActorSystem::~ZoneActorSystem() {
+    stop();
+    for (int i = 0; i < actorCount; i++) {
+        delete actors[i].mailbox;
+    }
+    delete[] actors;
+}
+
+bool ZoneActorSystem::start() {
+    if (running.load()) return false;
+    running.store(true);
+    system->setZoneActorsRunning(true);
+    for (int i = 0; i < actorCount; i++) {
+        actors[i].thread = std::thread(&ZoneActorSystem::actorLoop, this, i);
+    }
+    return true;
+}
+
+void ZoneActorSystem::stop() {
+    if (!running.load()) return;
+    waitIdle();
+    running.store(false);
+    for (int i = 0; i < actorCount; i++) {
+        { std::lock_guard<std::mutex> guard(actors[i].sleepLock); }
+        actors[i].wakeup.notify_one();
+        actors[i].thread.join();
+    }
+    system->setZoneActorsRunning(false);
+}
+
+void ZoneActorSystem::waitIdle() {
+    std::unique_lock<std::mutex> guard(idleLock);
+    while (inFlight.load() != 0) {
+        idle.wait(guard);
+    }
+}
+
+void ZoneActorSystem::deliver(int actor, const ZoneMessage& message) {
+    // inFlight never exceeds the mailbox capacity, so this only spins on a
+    // slot whose previous message is still being read
+    while (!actors[actor].mailbox->tryPush(message)) {
+        std::this_thread::yield();
+    }
+    { std::lock_guard<std::mutex> guard(actors[actor].sleepLock); }
+    actors[actor].wakeup.notify_one();
+}
+
+void ZoneActorSystem::finish() {
+    if (inFlight.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> guard(idleLock);
+        idle.notify_all();
+    }
+}
+
+bool ZoneActorSystem::allocate(int requestId) {
+    if (!running.load()) return false;
+
+    ParkingRequest* request = system->getRequestById(requestId);
+    if (request == nullptr || request->getState() != REQUESTED) return false;
+    int home = system->getZoneGraph()->findZoneIndex(request->getRequestedZoneId());
+    if (home < 0) return false;
+
+    if (inFlight.fetch_add(1) >= mailboxCapacity) {
+        finish();
+        return false;
+    }
+    ZoneMessage message;
+    message.type = ZONE_MSG_ALLOCATE;
+    message.request = request;
+    message.homeIndex = home;
+    deliver(home, message);
+    return true;
+}
+
+bool ZoneActorSystem::exit(int requestId) {
+    return post(ZONE_MSG_EXIT, requestId);
+}
+
+bool ZoneActorSystem::cancel(int requestId) {
+    return post(ZONE_MSG_CANCEL, requestId);
+}
+
+bool ZoneActorSystem::post(ZoneMessageType type, int requestId) {
+    if (!running.load()) return false;
+
+    // Routed to the actor owning the request's slot; the actor re-checks the state
+    RequestState state;
+    int slotHandle = system->getRequestSlot(requestId, state);
+    if (state != (type == ZONE_MSG_EXIT ? OCCUPIED : ALLOCATED)) return false;
+    Zone* zone = system->getSlotDirectory()->getZone(slotHandle);
+    if (zone == nullptr) return false;
+    int owner = system->getZoneGraph()->findZoneIndex(zone->getZoneId());
+    if (owner < 0) return false;
+
+    if (inFlight.fetch_add(1) >= mailboxCapacity) {
+        finish();
+        return false;
+    }
+    ZoneMessage message;
+    message.type = type;
+    message.requestId = requestId;
+    message.homeIndex = owner;
+    deliver(owner, message);
+    return true;
+}
+
+void ZoneActorSystem::actorLoop(int actor) {
+    ZoneActor& self = actors[actor];
+    ZoneMessage message;
+    while (true) {
+        if (self.mailbox->tryPop(message)) {
+            handle(actor, message);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(self.sleepLock);
+        while (self.mailbox->getSizeApprox() == 0 && running.load()) {
+            self.wakeup.wait(guard);
+        }
+        if (!running.load() && self.mailbox->getSizeApprox() == 0) {
+            return;
+        }
+    }
+}
+
+void ZoneActorSystem::handle(int actor, const ZoneMessage& message) {
+    if (message.type == ZONE_MSG_ALLOCATE) {
+        handleAllocate(actor, message);
+        return;
+    }
+
+    // Exit / cancel: this actor owns the slot's zone, so the release skips the shard lock
+    bool applied = (message.type == ZONE_MSG_EXIT)
+        ? system->markVehicleExited(message.requestId, true)
+        : system->cancelRequest(message.requestId, true);
+    if (applied) {
+        actors[actor].released++;
+    } else {
+        actors[actor].failed++;
+    }
+    finish();
+}
+
+void ZoneActorSystem::handleAllocate(int actor, ZoneMessage message) {
+    ZoneActor& self = actors[actor];
+    ParkingRequest* request = message.request;
+    if (request->getState() != REQUESTED) {
+        self.failed++;
+        finish();
+        return;
+    }
+
+    // Same admission, slot policy and negative cache as a direct claim; the
+    // slots need no lock, this thread is the zone's only writer
+    ZoneGraph* graph = system->getZoneGraph();
+    AllocationEngine* engine = system->getAllocationEngine();
+    bool isCrossZone = message.fallbackIndex >= 0;
+    if (engine->claimOwnedSlot(self.zone, request, isCrossZone) != nullptr) {
+        if (isCrossZone) {
+            self.crossZone++;
+        } else {
+            self.sameZone++;
+        }
+        finish();
+        return;
+    }
+
+    // Full: hand the request to the next zone on the requester's fallback list
+    const ZoneFallback* fallbacks = graph->getFallbacks(message.homeIndex);
+    int fallbackCount = graph->getFallbackCount(message.homeIndex);
+    int maxHops = engine->getMaxFallbackHops();
+    int maxCost = engine->getMaxFallbackCost();
+    for (int f = message.fallbackIndex + 1; f < fallbackCount; f++) {
+        if (maxCost >= 0 && fallbacks[f].cost > maxCost) break;
+        if (maxHops >= 0 && fallbacks[f].hops > maxHops) continue;
+
+        message.fallbackIndex = f;
+        self.forwarded++;
+        deliver(fallbacks[f].zoneIndex, message);
+        return;     // Still in flight
+    }
+
+    self.failed++;
+    finish();
+}
+
+int ZoneActorSystem::getActorCount() const {
+    return actorCount;
+}
+
+long long ZoneActorSystem::getForwardedCount() const {
+    long long total = 0;
+    for (int i = 0; i < actorCount; i++) {
+        total += actors[i].forwarded;
+    }
+    return total;
+}
+
+long long ZoneActorSystem::getSameZoneCount() const {
+    long long total = 0;
+    for (int i = 0; i < actorCount; i++) {
+        total += actors[i].sameZone;
+    }
+    return total;
+}
+
+long long ZoneActorSystem::getCrossZoneCount() const {
+    long long total = 0;
+    for (int i = 0; i < actorCount; i++) {
+        total += actors[i].crossZone;
+    }
+    return total;
+}
+
+long long ZoneActorSystem::getReleasedCount() const {
+    long long total = 0;
+    for (int i = 0; i < actorCount; i++) {
+        total += actors[i].released;
+    }
+    return total;
+}
+
+long long ZoneActorSystem::getFailedCount() const {
+    long long total = 0;
+    for (int i = 0; i < actorCount; i++) {
+        total += actors[i].failed;
+    }
+    return total;
+}
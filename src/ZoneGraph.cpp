@@ -0,0 +1,289 @@
+#include "include/ZoneGraph.h"
+#include "include/Zone.h"
+
+ZoneGraph::ZoneGraph()
+    : zones(16), idCapacity(16), dirty(true), compileCount(0), compiledZoneCount(0),
+      rowStart(nullptr), edgeTarget(nullptr), edgeWeight(nullptr), edgeCount(0),
+      fallbackStart(nullptr), fallbacks(nullptr) {
+    idKeys = new int[idCapacity];
+    idIndices = new int[idCapacity];
+    for (int i = 0; i < idCapacity; i++) {
+        idKeys[i] = EMPTY_KEY;
+        idIndices[i] = -1;
+    }
+}
+
+ZoneGraph::~ZoneGraph() {
+    releaseCompiled();
+    delete[] idKeys;
+    delete[] idIndices;
+}
+
+int ZoneGraph::probeIndex(int zoneId) const {
+    unsigned long long hash = (unsigned long long)(unsigned int)zoneId * 11400714819323198485ULL;
+    int mask = idCapacity - 1;
+    int index = (int)(hash >> 32) & mask;
+    while (idKeys[index] != EMPTY_KEY && idKeys[index] != zoneId) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void ZoneGraph::growIdTable() {
+    int oldCapacity = idCapacity;
+    int* oldKeys = idKeys;
+    int* oldIndices = idIndices;
+
+    idCapacity *= 2;
+    idKeys = new int[idCapacity];
+    idIndices = new int[idCapacity];
+    for (int i = 0; i < idCapacity; i++) {
+        idKeys[i] = EMPTY_KEY;
+        idIndices[i] = -1;
+    }
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldKeys[i] != EMPTY_KEY) {
+            int index = probeIndex(oldKeys[i]);
+            idKeys[index] = oldKeys[i];
+            idIndices[index] = oldIndices[i];
+        }
+    }
+
+    delete[] oldKeys;
+    delete[] oldIndices;
+}
+
+int ZoneGraph::addZone(Zone* zone) {
+    if (zone == nullptr) return -1;
+
+    int existing = findZoneIndex(zone->getZoneId());
+    if (existing >= 0) return existing;
+
+    if ((zones.getSize() + 1) * 2 > idCapacity) {
+        growIdTable();
+    }
+
+    int index = zones.getSize();
+    zones.add(zone);
+    int slot = probeIndex(zone->getZoneId());
+    idKeys[slot] = zone->getZoneId();
+    idIndices[slot] = index;
+    dirty = true;
+    return index;
+}
+
+void ZoneGraph::invalidate() {
+    dirty = true;
+}
+
+int ZoneGraph::findZoneIndex(int zoneId) const {
+    if (zoneId == EMPTY_KEY) return -1;
+    return idIndices[probeIndex(zoneId)];
+}
+
+Zone* ZoneGraph::findZone(int zoneId) const {
+    int index = findZoneIndex(zoneId);
+    return (index >= 0) ? zones[index] : nullptr;
+}
+
+Zone* ZoneGraph::getZone(int index) const {
+    if (index < 0 || index >= zones.getSize()) return nullptr;
+    return zones[index];
+}
+
+int ZoneGraph::getZoneCount() const {
+    return zones.getSize();
+}
+
+void ZoneGraph::releaseCompiled() {
+    delete[] rowStart;
+    delete[] edgeTarget;
+    delete[] edgeWeight;
+    delete[] fallbackStart;
+    delete[] fallbacks;
+    rowStart = nullptr;
+    edgeTarget = nullptr;
+    edgeWeight = nullptr;
+    fallbackStart = nullptr;
+    fallbacks = nullptr;
+    edgeCount = 0;
+    compiledZoneCount = 0;
+}
+
+void ZoneGraph::compile() {
+    releaseCompiled();
+    int n = zones.getSize();
+
+    // CSR adjacency; edges to unregistered zones are ignored
+    rowStart = new int[n + 1];
+    rowStart[0] = 0;
+    for (int i = 0; i < n; i++) {
+        int degree = 0;
+        for (int k = 0; k < zones[i]->getAdjacentZoneCount(); k++) {
+            int target = findZoneIndex(zones[i]->getAdjacentZone(k));
+            if (target >= 0 && target != i) degree++;
+        }
+        rowStart[i + 1] = rowStart[i] + degree;
+    }
+    edgeCount = rowStart[n];
+    edgeTarget = new int[edgeCount > 0 ? edgeCount : 1];
+    edgeWeight = new int[edgeCount > 0 ? edgeCount : 1];
+    for (int i = 0; i < n; i++) {
+        int e = rowStart[i];
+        for (int k = 0; k < zones[i]->getAdjacentZoneCount(); k++) {
+            int target = findZoneIndex(zones[i]->getAdjacentZone(k));
+            if (target >= 0 && target != i) {
+                int weight = zones[i]->getAdjacentZoneWeight(k);
+                edgeTarget[e] = target;
+                edgeWeight[e] = (weight < 1) ? 1 : weight;
+                e++;
+            }
+        }
+    }
+
+    // Fallback lists: one Dijkstra per zone (zone counts are small)
+    int* dist = new int[n > 0 ? n : 1];
+    int* hops = new int[n > 0 ? n : 1];
+    int* order = new int[n > 0 ? n : 1];
+    int* heap = new int[n > 0 ? n : 1];
+    int* heapPos = new int[n > 0 ? n : 1];
+    DynamicArray<ZoneFallback> collected(n > 0 ? n : 1);
+
+    fallbackStart = new int[n + 1];
+    fallbackStart[0] = 0;
+    for (int source = 0; source < n; source++) {
+        int reached = shortestPaths(source, dist, hops, order, heap, heapPos);
+        // order[0] is the source itself
+        for (int r = 1; r < reached; r++) {
+            ZoneFallback entry;
+            entry.zoneIndex = order[r];
+            entry.cost = dist[order[r]];
+            entry.hops = hops[order[r]];
+            collected.add(entry);
+        }
+        fallbackStart[source + 1] = collected.getSize();
+    }
+
+    int total = collected.getSize();
+    fallbacks = new ZoneFallback[total > 0 ? total : 1];
+    for (int i = 0; i < total; i++) {
+        fallbacks[i] = collected[i];
+    }
+
+    delete[] dist;
+    delete[] hops;
+    delete[] order;
+    delete[] heap;
+    delete[] heapPos;
+
+    compiledZoneCount = n;
+    compileCount++;
+    dirty.store(false, std::memory_order_release);
+}
+
+void ZoneGraph::ensureCompiled() {
+    if (!dirty.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> guard(compileLock);
+    if (dirty.load(std::memory_order_relaxed)) {
+        compile();
+    }
+}
+
+static bool heapLess(int a, int b, const int* dist, const int* hops) {
+    if (dist[a] != dist[b]) return dist[a] < dist[b];
+    if (hops[a] != hops[b]) return hops[a] < hops[b];
+    return a < b;
+}
+
+int ZoneGraph::shortestPaths(int source, int* dist, int* hops, int* order,
+                             int* heap, int* heapPos) const {
+    int n = zones.getSize();
+    for (int i = 0; i < n; i++) {
+        dist[i] = -1;
+        hops[i] = 0;
+        heapPos[i] = -1;
+    }
+
+    // Binary min-heap keyed by (cost, hops, index) so pop order is deterministic
+    int heapSize = 0;
+    int reached = 0;
+    dist[source] = 0;
+    heap[heapSize] = source;
+    heapPos[source] = heapSize++;
+
+    while (heapSize > 0) {
+        int u = heap[0];
+        heapPos[u] = -2;    // Settled
+        order[reached++] = u;
+
+        // Pop: move last to root and sift down
+        heapSize--;
+        if (heapSize > 0) {
+            int moved = heap[heapSize];
+            int pos = 0;
+            while (true) {
+                int child = pos * 2 + 1;
+                if (child >= heapSize) break;
+                if (child + 1 < heapSize && heapLess(heap[child + 1], heap[child], dist, hops)) child++;
+                if (!heapLess(heap[child], moved, dist, hops)) break;
+                heap[pos] = heap[child];
+                heapPos[heap[pos]] = pos;
+                pos = child;
+            }
+            heap[pos] = moved;
+            heapPos[moved] = pos;
+        }
+
+        for (int e = rowStart[u]; e < rowStart[u + 1]; e++) {
+            int v = edgeTarget[e];
+            if (heapPos[v] == -2) continue;
+
+            int candidate = dist[u] + edgeWeight[e];
+            int candidateHops = hops[u] + 1;
+            if (dist[v] >= 0 && (candidate > dist[v] ||
+                (candidate == dist[v] && candidateHops >= hops[v]))) {
+                continue;
+            }
+            dist[v] = candidate;
+            hops[v] = candidateHops;
+
+            // Insert or decrease key, then sift up
+            int pos = heapPos[v];
+            if (pos < 0) {
+                pos = heapSize++;
+            }
+            while (pos > 0) {
+                int parent = (pos - 1) / 2;
+                if (!heapLess(v, heap[parent], dist, hops)) break;
+                heap[pos] = heap[parent];
+                heapPos[heap[pos]] = pos;
+                pos = parent;
+            }
+            heap[pos] = v;
+            heapPos[v] = pos;
+        }
+    }
+    return reached;
+}
+
+int ZoneGraph::getEdgeCount() {
+    ensureCompiled();
+    return edgeCount;
+}
+
+int ZoneGraph::getFallbackCount(int zoneIndex) {
+    ensureCompiled();
+    if (zoneIndex < 0 || zoneIndex >= compiledZoneCount) return 0;
+    return fallbackStart[zoneIndex + 1] - fallbackStart[zoneIndex];
+}
+
+const ZoneFallback* ZoneGraph::getFallbacks(int zoneIndex) {
+    ensureCompiled();
+    if (zoneIndex < 0 || zoneIndex >= compiledZoneCount) return nullptr;
+    return &fallbacks[fallbackStart[zoneIndex]];
+}
+
+int ZoneGraph::getCompileCount() const {
+    return compileCount;
+}
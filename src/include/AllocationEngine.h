@@ -3,16 +3,83 @@
 
 #include "ParkingRequest.h"
 #include "ParkingSlot.h"
+#include "Queue.h"
+#include "ZoneGraph.h"
+#include "WorkStealingPool.h"
+#include "FallbackStats.h"
+#include <atomic>
 
 // Forward declarations
 class ParkingSystem;
 class RollbackManager;
+class Zone;
+
+// Outcome of one allocateBatch call
+struct BatchAllocationResult {
+    int processed;      // REQUESTED items drained from the queue
+    int sameZone;
+    int crossZone;
+    int requeued;       // No slot anywhere; left REQUESTED and queued again
+    int skipped;        // No longer REQUESTED (e.g. cancelled while queued)
+    float penaltyCost;  // Sum of crossZonePenalty x path cost over cross-zone allocations
+    
+    BatchAllocationResult() : processed(0), sameZone(0), crossZone(0), 
+                              requeued(0), skipped(0), penaltyCost(0.0f) {}
+    
+    int allocated() const { return sameZone + crossZone; }
+};
 
 class AllocationEngine {
 private:
     ParkingSystem* parkingSystem;
     RollbackManager* rollbackManager;
     float crossZonePenalty;
+    int maxFallbackHops;        // -1 = no hop limit
+    int maxFallbackCost;        // -1 = no cost limit
+    BatchAssignmentMode batchMode;
+    SlotPolicy slotPolicy;
+    FallbackPolicy fallbackPolicy;
+    WorkStealingPool* workerPool;   // Not owned; nullptr = batches run on the caller's thread
+    
+    // Fallback probe history; every single-request fallback probe is recorded
+    static const int LEARNED_ORDER_STACK = 32;  // Fallback lists up to this long are ordered on the stack
+    FallbackStats fallbackStats;
+    int fallbackHour;               // -1 = current UTC hour
+    std::atomic<long long> wastedProbes;        // Cross-zone claims that locked a zone and found nothing
+    std::atomic<long long> negativeCacheSkips;  // Cross-zone claims skipped by a zone's miss cache
+    
+    struct ZoneBatchTask;           // Per-group state for parallel batches (AllocationEngine.cpp)
+    
+    bool withinFallbackLimits(const ZoneFallback& fallback) const;
+    void commitAllocation(Zone* zone, ParkingRequest* request, ParkingSlot* slot, bool isCrossZone);
+    int fillFromZone(Zone* zone, ParkingRequest** requests, int count,
+                     ParkingSlot** slotBuffer, bool isCrossZone);
+    
+    // Find + commit under the zone's shard lock; nullptr if the zone is full
+    ParkingSlot* selectSlot(Zone* zone, const ParkingRequest* request);     // Under the shard lock; SlotPolicy dispatch
+    ParkingSlot* claimSlotInZone(Zone* zone, ParkingRequest* request, bool isCrossZone);
+    ParkingSlot* claimSlotInAdjacentZones(ParkingRequest* request);  // Walks the distance-ordered fallback list
+    template <class FallbackOrder>
+    ParkingSlot* claimInFallbackOrder(ParkingRequest* request, int source, const ZoneFallback* fallbacks,
+                                      int count);
+    ParkingSlot* claimInLearnedOrder(ParkingRequest* request, int source, const ZoneFallback* fallbacks,
+                                     int count);
+    ParkingSlot* probeFallback(ParkingRequest* request, int source, const ZoneFallback* fallbacks,
+                               int position);     // Claim + record the outcome
+    int currentFallbackHour() const;
+    
+    // Batch strategies; group g is requests[groupStart[g] .. groupStart[g + 1])
+    void assignGreedy(ParkingRequest** requests, const int* groupZoneIds, const int* groupStart,
+                      int groupCount, ParkingSlot** slotBuffer, BatchAllocationResult& result);
+    void assignMinCost(ParkingRequest** requests, const int* groupZoneIds, const int* groupStart,
+                       int groupCount, ParkingSlot** slotBuffer, BatchAllocationResult& result);
+    int countAdmissible(Zone* zone, ParkingRequest** requests, int count, int& eligible);  // Min-cost edge capacity
+    void assignParallel(ParkingRequest** requests, const int* groupZoneIds, const int* groupStart,
+                        int groupCount, ParkingSlot** slotBuffer, BatchAllocationResult& result);
+    
+    // Pool tasks: one own-zone task per group; spill runs as one follow-up task per fallback hop
+    static void runOwnZoneTask(void* context, WorkStealingPool* pool, int worker);
+    static void runSpillTask(void* context, WorkStealingPool* pool, int worker);
     
 public:
     // Constructor
@@ -20,15 +87,39 @@ public:
     
     // Allocation Methods
     bool allocateSlot(ParkingRequest* request);
-    bool cancelAllocation(ParkingRequest* request);
+    bool cancelAllocation(ParkingRequest* request, bool zoneOwned = false);   // zoneOwned: see ParkingSystem::markVehicleExited
+    ParkingSlot* allocateInZone(ParkingRequest* request, Zone* zone, bool isCrossZone);  // Quiet; one zone only
+    bool allocateReservedSlot(ParkingRequest* request, int slotHandle);   // Check-in on a SLOT_RESERVED hold
+    int walkInHoldback(Zone* zone, const ParkingRequest* request);   // Under the zone's shard lock
+    // ZoneActorSystem path: the caller is the zone's only slot writer, so the
+    // search and commit take no shard lock (the holdback read still does)
+    ParkingSlot* claimOwnedSlot(Zone* zone, ParkingRequest* request, bool isCrossZone);
     
-    // Strategy
-    ParkingSlot* findSlotInZone(int zoneId);
-    ParkingSlot* findSlotInAdjacentZones(int requestedZoneId);
+    // Batch Allocation (quiet; groups by requested zone, one free-slot pass per zone).
+    // The multi-level form drains levels[levelCount - 1] first (one level per
+    // RequestClass) and re-queues leftovers on their class's level.
+    BatchAllocationResult allocateBatch(Queue<ParkingRequest*>& pending);
+    BatchAllocationResult allocateBatch(Queue<ParkingRequest*>* levels, int levelCount);
     
     // Configuration
     void setCrossZonePenalty(float penalty);
     float getCrossZonePenalty() const;
+    void setFallbackLimits(int maxHops, int maxCost);
+    int getMaxFallbackHops() const;
+    int getMaxFallbackCost() const;
+    void setBatchAssignmentMode(BatchAssignmentMode mode);
+    BatchAssignmentMode getBatchAssignmentMode() const;
+    void setSlotPolicy(SlotPolicy policy);          // See AllocationPolicies.h
+    SlotPolicy getSlotPolicy() const;
+    void setFallbackPolicy(FallbackPolicy policy);  // Single-request fallback only; batches keep their own plans
+    FallbackPolicy getFallbackPolicy() const;
+    void setFallbackHour(int hour);                 // Pins the hour stats are kept under; -1 = clock
+    int getLearnedFallbackOrder(int zoneId, int hour, DynamicArray<int>& zoneIds);  // Zone IDs, best first
+    void clearFallbackStats();
+    long long getWastedProbes() const;
+    long long getNegativeCacheSkips() const;
+    void setWorkerPool(WorkStealingPool* pool);     // Greedy batches fan out per zone
+    WorkStealingPool* getWorkerPool() const;
 };
 
 #endif // ALLOCATION_ENGINE_H
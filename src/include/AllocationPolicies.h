@@ -0,0 +1,159 @@
+#ifndef ALLOCATION_POLICIES_H
+#define ALLOCATION_POLICIES_H
+
+#include "Zone.h"
+#include "ParkingArea.h"
+#include "ZoneGraph.h"
+
+// Compile-time allocation strategies. A SlotSelector combines an area-order
+// policy (which area of a zone to search next) with a slot-choice policy
+// (which free slot inside that area); every call is resolved at compile time,
+// so the search loop has no virtual dispatch. AllocationEngine picks an
+// instantiation once per claim from its SlotPolicy; benchmarks and tools can
+// instantiate any combination directly.
+//
+// All policies run under the zone's shard lock; their cursors live on the
+// Zone and ParkingArea they steer.
+
+// ---- Area order: begin() gives the first candidate area, next() the one
+// after `current` (-1 when done), chosen() records the area that supplied a slot
+
+// Lowest-index area with capacity first
+struct FirstFitAreas {
+    static int begin(Zone* zone) {
+        return zone->findNextAreaWithCapacity(0);
+    }
+    static int next(Zone* zone, int, int current) {
+        return zone->findNextAreaWithCapacity(current + 1);
+    }
+    static void chosen(Zone*, int) {}
+};
+
+// Start one past the area used last, wrapping around
+struct RoundRobinAreas {
+    static int begin(Zone* zone) {
+        int index = zone->findNextAreaWithCapacity(zone->getAreaCursor() + 1);
+        return index >= 0 ? index : zone->findNextAreaWithCapacity(0);
+    }
+    static int next(Zone* zone, int first, int current) {
+        int index = zone->findNextAreaWithCapacity(current + 1);
+        if (index < 0) index = zone->findNextAreaWithCapacity(0);
+        return index == first ? -1 : index;
+    }
+    static void chosen(Zone* zone, int index) {
+        zone->setAreaCursor(index);
+    }
+};
+
+// Emptiest area (largest free fraction) first, then the rest in index order
+struct LeastUtilizedArea {
+    static int begin(Zone* zone) {
+        int best = -1;
+        float bestFree = -1.0f;
+        for (int index = zone->findNextAreaWithCapacity(0); index >= 0;
+             index = zone->findNextAreaWithCapacity(index + 1)) {
+            ParkingArea* area = zone->getAreaByIndex(index);
+            float freeFraction = (float)area->getAvailableSlots() / area->getTotalSlots();
+            if (freeFraction > bestFree) {
+                bestFree = freeFraction;
+                best = index;
+            }
+        }
+        return best;
+    }
+    static int next(Zone* zone, int first, int current) {
+        int index = zone->findNextAreaWithCapacity(current == first ? 0 : current + 1);
+        if (index == first) index = zone->findNextAreaWithCapacity(index + 1);
+        return index;
+    }
+    static void chosen(Zone*, int) {}
+};
+
+// ---- Slot choice: pick() returns a free slot of the area with every
+// required attribute, or nullptr
+
+// Lowest free slot (honours the area's SlotSearchMode when unconstrained)
+struct FirstFitSlot {
+    static ParkingSlot* pick(ParkingArea* area, unsigned int required) {
+        return area->findFirstAvailableSlotWith(required);
+    }
+};
+
+// Resume after the slot handed out last, wrapping once; spreads wear and
+// keeps a churning area from rescanning its full prefix
+struct NextFitSlot {
+    static ParkingSlot* pick(ParkingArea* area, unsigned int required) {
+        int from = area->getNextFitCursor();
+        ParkingSlot* slot = area->findNextAvailableSlotWith(from, required);
+        if (slot == nullptr && from > 0) {
+            slot = area->findNextAvailableSlotWith(0, required);
+        }
+        if (slot != nullptr) {
+            area->setNextFitCursor(slot->getSlotIndex() + 1);
+        }
+        return slot;
+    }
+};
+
+template <class AreaOrder, class SlotChoice>
+struct SlotSelector {
+    // First slot of a free run of `length` slots (runs always take the
+    // lowest-index run in an area), nullptr if no area has one
+    static ParkingSlot* select(Zone* zone, unsigned int required, int length = 1) {
+        int first = AreaOrder::begin(zone);
+        for (int index = first; index >= 0; index = AreaOrder::next(zone, first, index)) {
+            ParkingArea* area = zone->getAreaByIndex(index);
+            ParkingSlot* slot = nullptr;
+            if (length > 1) {
+                int run = area->getAvailableSlots() < length ? -1 : area->findFreeRun(length, required);
+                slot = area->getSlotByIndex(run);
+            } else {
+                slot = SlotChoice::pick(area, required);
+            }
+            if (slot != nullptr) {
+                AreaOrder::chosen(zone, index);
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+};
+
+typedef SlotSelector<FirstFitAreas, FirstFitSlot> FirstFitSelector;
+typedef SlotSelector<FirstFitAreas, NextFitSlot> NextFitSelector;
+typedef SlotSelector<LeastUtilizedArea, FirstFitSlot> LeastUtilizedSelector;
+typedef SlotSelector<RoundRobinAreas, FirstFitSlot> RoundRobinSelector;
+
+// ---- Fallback order: preferred() names the entry of fallbacks[0 .. count)
+// within the hop limit (-1 = none) to try first, or -1; the engine then
+// walks the rest nearest-first
+
+struct NearestFallback {
+    static int preferred(ZoneGraph*, const ZoneFallback* fallbacks, int count, int maxHops) {
+        for (int i = 0; i < count; i++) {
+            if (maxHops < 0 || fallbacks[i].hops <= maxHops) return i;
+        }
+        return -1;
+    }
+};
+
+struct LeastUtilizedFallback {
+    static int preferred(ZoneGraph* graph, const ZoneFallback* fallbacks, int count, int maxHops) {
+        int best = -1;
+        float bestFree = 0.0f;
+        for (int i = 0; i < count; i++) {
+            if (maxHops >= 0 && fallbacks[i].hops > maxHops) continue;
+            Zone* zone = graph->getZone(fallbacks[i].zoneIndex);
+            int total = zone->getTotalSlots();
+            if (total <= 0) continue;
+            float freeFraction = (float)zone->getOccupancy()->getAvailableSlots() / total;
+            if (freeFraction > bestFree) {
+                bestFree = freeFraction;
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+#endif // ALLOCATION_POLICIES_H
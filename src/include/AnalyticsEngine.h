@@ -4,6 +4,7 @@
 #include "LinkedList.h"
 #include "Zone.h"
 #include "DynamicArray.h"
+#include "WorkStealingPool.h"
 #include <ctime>
 
 // Forward declaration
@@ -61,7 +62,16 @@ class AnalyticsEngine {
 private:
     LinkedList<TripHistory>* tripHistory;
     DynamicArray<Zone*>* zones;
+    const OccupancyCounter* cityOccupancy;
     int totalRolledBackOperations;
+    WorkStealingPool* workerPool;   // Not owned; per-zone stats run as parallel tasks when set
+    
+    struct ZoneStatsTask {
+        AnalyticsEngine* engine;
+        Zone* zone;
+        ZoneStats* stats;
+    };
+    static void runZoneStatsTask(void* context, WorkStealingPool* pool, int worker);
     
     // Helper methods
     long long calculateTotalDuration(bool completedOnly);
@@ -70,7 +80,10 @@ private:
     
 public:
     // Constructor
-    AnalyticsEngine(LinkedList<TripHistory>* history, DynamicArray<Zone*>* zoneList);
+    AnalyticsEngine(LinkedList<TripHistory>* history, DynamicArray<Zone*>* zoneList,
+                    const OccupancyCounter* cityCounter);
+    
+    void setWorkerPool(WorkStealingPool* pool);
     
     // Core Analytics Methods
     float calculateAverageParkingDuration();
@@ -0,0 +1,49 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+// Packed bit set stored as 64-bit words.
+// Used as a free-slot index: bit i set means slot i is available.
+class Bitmap {
+private:
+    unsigned long long* words;
+    int bitCount;
+    int wordCount;
+    int setCount;
+
+    static int wordsFor(int bits);
+
+public:
+    // Constructors & Destructor
+    Bitmap(int bits = 0, bool initialValue = false);
+    ~Bitmap();
+
+    Bitmap(const Bitmap& other) = delete;
+    Bitmap& operator=(const Bitmap& other) = delete;
+
+    // Bit Operations
+    void set(int index);
+    void clear(int index);
+    void assign(int index, bool value);
+    void setRange(int fromIndex, int toIndex);
+    bool test(int index) const;
+    void resize(int bits, bool newBitsValue = false);
+
+    // Queries
+    int findFirstSet() const;
+    int findNextSet(int fromIndex) const;
+    int count() const;
+    int size() const;
+    bool none() const;
+
+    // Raw word access (for word-at-a-time scans)
+    int getWordCount() const;
+    unsigned long long getWord(int wordIndex) const;
+    const unsigned long long* getWords() const;     // getWordCount() words
+
+    // Bit Utilities
+    static int countTrailingZeros(unsigned long long word);
+    static int countLeadingZeros(unsigned long long word);
+    static int popCount(unsigned long long word);
+};
+
+#endif // BITMAP_H
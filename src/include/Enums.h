@@ -18,4 +18,77 @@ enum SlotStatus {
     SLOT_MAINTENANCE   // Optional: slot temporarily unavailable
 };
 
+// Slot attribute flags, combined into a mask; a request's required mask
+// must be a subset of its slot's attributes
+enum SlotAttribute {
+    ATTR_EV_CHARGER = 1 << 0,
+    ATTR_ACCESSIBLE = 1 << 1,
+    ATTR_OVERSIZE = 1 << 2,    // Vans, trailers
+    ATTR_COMPACT = 1 << 3
+};
+const int SLOT_ATTRIBUTE_COUNT = 4;
+
+// Request priority classes, lowest first. A class may use free capacity
+// beyond the unused reserves of the classes above it.
+enum RequestClass {
+    CLASS_STANDARD,
+    CLASS_PERMIT,          // Permit holders
+    CLASS_ACCESSIBILITY,   // Accessibility users
+    CLASS_EMERGENCY        // Emergency vehicles
+};
+const int REQUEST_CLASS_COUNT = 4;
+
+// Advance reservation lifecycle
+enum ReservationState {
+    RESERVATION_NONE,       // Unknown reservation ID
+    RESERVATION_BOOKED,     // Counted in the zone calendar, no slot held yet
+    RESERVATION_HELD,       // A slot is SLOT_RESERVED for it
+    RESERVATION_CHECKED_IN, // Turned into an ALLOCATED request on the held slot
+    RESERVATION_CANCELLED,
+    RESERVATION_EXPIRED     // Held slot not claimed within the grace period
+};
+
+// Free-slot search strategy used by ParkingArea
+enum SlotSearchMode {
+    SEARCH_BITMAP,     // Word-at-a-time scan of the free-slot bitmap (default)
+    SEARCH_LINEAR,     // Reference pointer walk over every slot (for benchmarking)
+    SEARCH_SIMD        // Vectorized scan of the SlotTable status column
+};
+
+// How AllocationEngine::allocateBatch places a drained batch
+enum BatchAssignmentMode {
+    BATCH_GREEDY,      // Own zone first, then overflow walks fallback lists group by group
+    BATCH_MIN_COST     // Min-cost max-flow: most placements, then least penalty among them
+};
+
+// Which free slot AllocationEngine picks in a zone (see AllocationPolicies.h)
+enum SlotPolicy {
+    POLICY_FIRST_FIT,            // First area with capacity, lowest free slot (default)
+    POLICY_NEXT_FIT,             // Per-area cursor resumes after the last slot handed out
+    POLICY_LEAST_UTILIZED_AREA,  // Emptiest area by free fraction, lowest free slot in it
+    POLICY_ROUND_ROBIN_AREAS     // Areas take turns, lowest free slot in each
+};
+
+// Which fallback zone a full zone's requests try first
+enum FallbackPolicy {
+    FALLBACK_NEAREST,            // Distance-ordered fallback list (default)
+    FALLBACK_LEAST_UTILIZED,     // Emptiest zone within the limits first, then nearest
+    FALLBACK_ADAPTIVE            // Best recent hit rate for this zone and hour first (FallbackStats)
+};
+
+// Gate events applied by GateIngest's allocator thread
+enum GateEventType {
+    GATE_CREATE,       // New request for a zone, allocated immediately
+    GATE_ARRIVE,       // Vehicle entered its allocated slot
+    GATE_EXIT,         // Vehicle left; slot released
+    GATE_CANCEL        // Request withdrawn
+};
+
+// Messages exchanged between zone actors (ZoneActorSystem)
+enum ZoneMessageType {
+    ZONE_MSG_ALLOCATE, // Place a request here or forward it along its fallback list
+    ZONE_MSG_EXIT,     // An OCCUPIED request in one of this zone's slots leaves
+    ZONE_MSG_CANCEL    // An ALLOCATED request holding one of this zone's slots is withdrawn
+};
+
 #endif // ENUMS_H
@@ -0,0 +1,70 @@
+#ifndef FALLBACK_STATS_H
+#define FALLBACK_STATS_H
+
+#include "DynamicArray.h"
+#include <atomic>
+#include <mutex>
+
+// Per source zone and hour of day, how often a probe of each fallback-list
+// entry found a slot. Each (source, hour) row keeps its entries sorted by the
+// smoothed hit rate (hits + 1) / (probes + 2), best first, ties nearest
+// first; a recorded probe moves only its own entry, by adjacent swaps. An
+// entry's counts are halved once it reaches WINDOW probes, so old traffic
+// fades. Rows start in nearest-first order and reset whenever the zone graph
+// recompiles (the fallback lists they index may have changed).
+// Each row has its own lock, and finding a row takes none, so claims from
+// different source zones or hours never wait on each other.
+class FallbackStats {
+private:
+    struct Entry {
+        int position;   // Index into the source's fallback list
+        int probes;
+        int hits;
+
+        Entry() : position(0), probes(0), hits(0) {}
+    };
+
+    struct Row {
+        std::mutex lock;    // Guards the fields below
+        int stamp;          // ZoneGraph compile count the entries belong to
+        int count;          // Fallback-list length
+        Entry* entries;
+
+        Row() : stamp(-1), count(0), entries(nullptr) {}
+    };
+
+    // Row pointers by source * HOURS + hour, nullptr until first used. Rows
+    // are created, and the directory grown, under directoryLock. A grown
+    // directory replaces the old one, which readers may still hold, so
+    // replaced directories are freed with the stats.
+    struct Directory {
+        int capacity;
+        std::atomic<Row*>* rows;
+    };
+
+    std::atomic<Directory*> directory;
+    DynamicArray<Directory*> replacedDirectories;
+    std::mutex directoryLock;
+
+    Row* findRow(int source, int hour);
+    static void prepareRow(Row* row, int stamp, int count);    // Under the row's lock
+    static bool ranksBefore(const Entry& a, const Entry& b);
+
+public:
+    static const int HOURS = 24;
+    static const int WINDOW = 64;
+
+    FallbackStats();
+    ~FallbackStats();
+
+    FallbackStats(const FallbackStats& other) = delete;
+    FallbackStats& operator=(const FallbackStats& other) = delete;
+
+    // Writes the row's count fallback positions to positions, best expected
+    // success first; returns how many were written (0 for a bad source or hour)
+    int getOrder(int source, int hour, int stamp, int count, int* positions);
+    void record(int source, int hour, int stamp, int count, int position, bool hit);
+    void clear();
+};
+
+#endif // FALLBACK_STATS_H
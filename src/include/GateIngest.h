@@ -0,0 +1,73 @@
+#ifndef GATE_INGEST_H
+#define GATE_INGEST_H
+
+#include "Enums.h"
+#include "MpscRing.h"
+#include <atomic>
+#include <thread>
+
+// Forward declaration
+class ParkingSystem;
+
+// One gate event; plates are copied inline so producers never touch shared state
+struct GateEvent {
+    static const int PLATE_BYTES = 24;
+
+    GateEventType type;
+    int zoneId;                     // GATE_CREATE only
+    char vehicleId[PLATE_BYTES];
+
+    GateEvent() : type(GATE_CREATE), zoneId(0) { vehicleId[0] = '\0'; }
+};
+
+// Ingestion front-end for gate controllers.
+// Any number of producer threads post events into a bounded lock-free ring;
+// one allocator thread applies them to the ParkingSystem in ring order. Posting
+// is a single CAS and never waits on allocation - a full ring is reported to the
+// caller instead. Events from one producer are applied in the order it posted them.
+class GateIngest {
+private:
+    ParkingSystem* system;
+    MpscRing<GateEvent> ring;
+    std::thread allocator;
+    std::atomic<bool> running;
+
+    std::atomic<long long> postedCount;
+    std::atomic<long long> rejectedCount;   // Ring full or plate too long
+    long long appliedCount;                 // Written by the consumer only
+    long long failedCount;                  // Applied but refused by ParkingSystem
+
+    bool post(GateEventType type, const char* vehicleId, int zoneId);
+    bool apply(const GateEvent& event);
+    void run();
+
+public:
+    // Constructor & Destructor
+    GateIngest(ParkingSystem* parkingSystem, int capacity = 4096);
+    ~GateIngest();
+
+    GateIngest(const GateIngest& other) = delete;
+    GateIngest& operator=(const GateIngest& other) = delete;
+
+    // Allocator Thread
+    bool start();
+    void stop();        // Joins the thread, then applies anything still queued
+    int drain();        // Apply queued events on the calling thread (only while stopped)
+    bool isRunning() const;
+
+    // Producers (any thread; false when the ring is full)
+    bool postCreate(const char* vehicleId, int zoneId);
+    bool postArrive(const char* vehicleId);
+    bool postExit(const char* vehicleId);
+    bool postCancel(const char* vehicleId);
+
+    // Statistics
+    long long getPostedCount() const;
+    long long getRejectedCount() const;
+    long long getAppliedCount() const;
+    long long getFailedCount() const;
+    int getBacklog() const;
+    int getCapacity() const;
+};
+
+#endif // GATE_INGEST_H
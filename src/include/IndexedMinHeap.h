@@ -0,0 +1,45 @@
+#ifndef INDEXED_MIN_HEAP_H
+#define INDEXED_MIN_HEAP_H
+
+#include "DynamicArray.h"
+
+// Binary min-heap of (key, id) pairs with an id -> heap position index, so an
+// entry can be removed or re-keyed by id in O(log n). Ids are small
+// non-negative integers (request IDs); the position index grows to the
+// largest id seen.
+class IndexedMinHeap {
+private:
+    struct HeapEntry {
+        long long key;
+        int id;
+
+        HeapEntry() : key(0), id(-1) {}
+    };
+
+    DynamicArray<HeapEntry> entries;
+    DynamicArray<int> positions;    // id -> index in entries, -1 = absent
+
+    void place(int index, const HeapEntry& entry);
+    void siftUp(int index);
+    void siftDown(int index);
+
+public:
+    IndexedMinHeap(int initialCapacity = 64);
+
+    // Updates the key if the id is already present
+    bool push(int id, long long key);
+    bool remove(int id);
+    bool contains(int id) const;
+    long long getKey(int id) const;     // -1 if absent
+
+    bool isEmpty() const;
+    int getSize() const;
+    int topId() const;                  // -1 if empty
+    long long topKey() const;
+    int pop();                          // Removes the minimum; returns its id, -1 if empty
+
+    // Appends every id whose key is <= limit; visits only those entries and their children
+    int collectAtMost(long long limit, DynamicArray<int>& ids) const;
+};
+
+#endif // INDEXED_MIN_HEAP_H
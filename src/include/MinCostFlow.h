@@ -0,0 +1,39 @@
+#ifndef MIN_COST_FLOW_H
+#define MIN_COST_FLOW_H
+
+#include "DynamicArray.h"
+
+// Min-cost max-flow solver (successive shortest paths with Bellman-Ford/SPFA).
+// Edges are stored in pairs: edge e and its residual twin e ^ 1.
+// Used by AllocationEngine's min-cost batch mode, where the network is tiny
+// (one node per request group and per zone) even for thousands of requests.
+class MinCostFlow {
+private:
+    int nodeCount;
+    DynamicArray<int> edgeTo;
+    DynamicArray<int> edgeCapacity;     // Residual capacity
+    DynamicArray<long long> edgeCost;
+    DynamicArray<int> edgeNext;
+    int* head;                          // First edge out of each node, -1 if none
+    int augmentCount;
+
+public:
+    // Constructor & Destructor
+    MinCostFlow(int nodes);
+    ~MinCostFlow();
+
+    MinCostFlow(const MinCostFlow& other) = delete;
+    MinCostFlow& operator=(const MinCostFlow& other) = delete;
+
+    // Network Construction (returns the forward edge index)
+    int addEdge(int from, int to, int capacity, long long cost);
+
+    // Solve: pushes maximum flow at minimum total cost, returns the flow
+    int solve(int source, int sink, long long& totalCost);
+
+    // Results
+    int getFlow(int edge) const;
+    int getAugmentCount() const;
+};
+
+#endif // MIN_COST_FLOW_H
@@ -0,0 +1,104 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+
+// Bounded lock-free multi-producer / single-consumer ring.
+// Each cell carries a sequence number: a producer claims a position with one
+// CAS on the tail and publishes by bumping the cell's sequence; the single
+// consumer reads cells in position order without any atomic RMW. Producers
+// never wait on the consumer - tryPush fails when the ring is full.
+template <typename T>
+class MpscRing {
+private:
+    struct Cell {
+        std::atomic<unsigned int> sequence;
+        T value;
+    };
+
+    Cell* cells;
+    unsigned int mask;      // capacity - 1 (capacity is a power of two)
+    alignas(64) std::atomic<unsigned int> tail;     // Next position to claim (producers)
+    alignas(64) std::atomic<unsigned int> head;     // Next position to read (written by the consumer only)
+
+public:
+    MpscRing(int minCapacity = 1024);
+    ~MpscRing();
+
+    MpscRing(const MpscRing& other) = delete;
+    MpscRing& operator=(const MpscRing& other) = delete;
+
+    bool tryPush(const T& item);    // Any thread; false when full
+    bool tryPop(T& item);           // Consumer thread only; false when empty
+    int getCapacity() const;
+    int getSizeApprox() const;
+};
+
+// Template implementation
+template <typename T>
+MpscRing<T>::MpscRing(int minCapacity) : tail(0), head(0) {
+    unsigned int capacity = 2;
+    while ((int)capacity < minCapacity) {
+        capacity *= 2;
+    }
+    mask = capacity - 1;
+    cells = new Cell[capacity];
+    for (unsigned int i = 0; i < capacity; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+MpscRing<T>::~MpscRing() {
+    delete[] cells;
+}
+
+template <typename T>
+bool MpscRing<T>::tryPush(const T& item) {
+    unsigned int position = tail.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[position & mask];
+        unsigned int sequence = cell.sequence.load(std::memory_order_acquire);
+        int lag = (int)(sequence - position);
+        if (lag == 0) {
+            // Cell is free for this lap; claim the position
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.value = item;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            return false;   // Consumer has not freed this cell yet: full
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool MpscRing<T>::tryPop(T& item) {
+    unsigned int position = head.load(std::memory_order_relaxed);
+    Cell& cell = cells[position & mask];
+    unsigned int sequence = cell.sequence.load(std::memory_order_acquire);
+    if ((int)(sequence - (position + 1)) < 0) {
+        return false;       // Not yet published
+    }
+    item = cell.value;
+    // Free the cell for the producers' next lap
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+    head.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+int MpscRing<T>::getCapacity() const {
+    return (int)(mask + 1);
+}
+
+template <typename T>
+int MpscRing<T>::getSizeApprox() const {
+    int size = (int)(tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed));
+    return (size < 0) ? 0 : size;
+}
+
+#endif // MPSC_RING_H
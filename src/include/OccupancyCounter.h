@@ -0,0 +1,45 @@
+#ifndef OCCUPANCY_COUNTER_H
+#define OCCUPANCY_COUNTER_H
+
+#include "SlotKernels.h"
+#include <atomic>
+
+// Per-status slot counts for one level of the area -> zone -> city hierarchy.
+// Every slot transition is applied to the area's counter and forwarded up the
+// parent chain, so capacity and utilization are O(1) reads at every level.
+// Counts are relaxed atomics: zones update their own chain under their shard
+// lock, but the shared city level is written by every zone concurrently.
+class OccupancyCounter {
+private:
+    static const int STATUS_COUNT = 4;
+
+    std::atomic<int> counts[STATUS_COUNT];      // Indexed by SlotStatus
+    OccupancyCounter* parent;
+
+    void apply(const SlotStatusCounts& delta, int sign);
+
+public:
+    // Constructor
+    OccupancyCounter();
+
+    OccupancyCounter(const OccupancyCounter& other) = delete;
+    OccupancyCounter& operator=(const OccupancyCounter& other) = delete;
+
+    // Hierarchy (this level's current counts are merged into the new parent)
+    void attachTo(OccupancyCounter* parentCounter);
+
+    // Updates (propagated to every ancestor)
+    void addSlots(int count, SlotStatus status = SLOT_AVAILABLE);
+    void transition(SlotStatus from, SlotStatus to);
+    void resync(const SlotStatusCounts& actual);
+
+    // Queries
+    int getTotalSlots() const;
+    int getCount(SlotStatus status) const;
+    int getAvailableSlots() const;
+    int getUnavailableSlots() const;
+    float getUtilization() const;
+    SlotStatusCounts getCounts() const;         // Snapshot
+};
+
+#endif // OCCUPANCY_COUNTER_H
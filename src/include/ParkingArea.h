@@ -2,15 +2,47 @@
 #define PARKING_AREA_H
 
 #include "ParkingSlot.h"
+#include "SlotTable.h"
+#include "Bitmap.h"
+#include "OccupancyCounter.h"
+
+// Forward declaration
+class Zone;
 
 class ParkingArea {
 private:
     int areaId;
     int zoneId;
     char* areaName;
-    ParkingSlot** slots;
     int totalSlots;
-    int occupiedSlots;
+    OccupancyCounter occupancy;  // Per-status counts; parent is the owner zone's counter
+    int firstSlotId;            // Slot IDs are firstSlotId + index
+    SlotTable slotTable;        // SoA slot storage; ParkingSlot objects are views into it
+    Bitmap freeSlots;           // Bit i set when slots[i] is SLOT_AVAILABLE
+    Bitmap attributeSlots[SLOT_ATTRIBUTE_COUNT];   // Bit i of [b] set when slots[i] has attribute 1 << b
+    SlotSearchMode searchMode;
+    Zone* ownerZone;
+    int areaIndex;
+    int nextFitCursor;          // Where a next-fit search resumes (under the zone's shard lock)
+    
+    // Word arrays a scan ANDs together: the free bitmap and each required
+    // attribute bitmap, looked up once per scan rather than once per word
+    struct ScanWords {
+        const unsigned long long* free;
+        const unsigned long long* attributes[SLOT_ATTRIBUTE_COUNT];
+        int attributeCount;
+        
+        unsigned long long at(int wordIndex) const {
+            unsigned long long word = free[wordIndex];
+            for (int a = 0; a < attributeCount && word != 0; a++) {
+                word &= attributes[a][wordIndex];
+            }
+            return word;
+        }
+    };
+    void resolveScanWords(unsigned int required, ScanWords& scan) const;
+    // Next free slot index at or after fromIndex with every required attribute, -1 if none
+    int findNextAvailableIndex(int fromIndex, unsigned int required) const;
     
 public:
     // Constructors & Destructor
@@ -25,15 +57,52 @@ public:
     int getOccupiedSlots() const;
     int getAvailableSlots() const;
     float getUtilization() const;
+    bool hasAvailableSlot() const;
+    OccupancyCounter* getOccupancy();
     
     // Slot Management
     ParkingSlot* findFirstAvailableSlot();
+    ParkingSlot* findFirstAvailableSlotLinear();
+    ParkingSlot* findFirstAvailableSlotBitmap();
+    ParkingSlot* findFirstAvailableSlotSimd();
+    ParkingSlot* findFirstAvailableSlotWith(unsigned int required);
+    ParkingSlot* findNextAvailableSlotWith(int fromIndex, unsigned int required);
+    int findFreeRun(int length, unsigned int required = 0) const;  // First index of `length` adjacent free slots, -1 if none
+    ParkingSlot* findFirstInServiceSlot();
     ParkingSlot* getSlotById(int slotId);
+    ParkingSlot* getSlotByIndex(int index);
+    SlotTable* getSlotTable();
+    int collectAvailableSlots(ParkingSlot** out, int maxCount, unsigned int required = 0);
+    int countAvailableSlots(unsigned int required = 0) const;    // Free slots with every required attribute
+    static int getSlotIdStride(int slotCount);
     bool allocateSlot(int slotId, const char* vehicleId);
     bool releaseSlot(int slotId);
     
+    // Runs of adjacent slots (buses, trailers) change together or not at all
+    bool allocateRun(int firstIndex, int length, VehicleHandle vehicle);
+    bool releaseRun(int firstIndex, int length);
+    
+    // Single transition point: every slot status write goes through here and
+    // updates the free-slot index, the occupancy counters and the zone summary
+    bool transitionSlot(int slotIndex, SlotStatus newStatus);
+    
+    // Slot Attributes (free bitmap AND attribute bitmaps, a word at a time)
+    void setSlotAttributes(int slotIndex, unsigned int mask);
+    bool offersAttributes(unsigned int required) const;    // Some slot here has them all
+    
+    // Free-Slot Index
+    void setSearchMode(SlotSearchMode mode);
+    SlotSearchMode getSearchMode() const;
+    
+    int getNextFitCursor() const;
+    void setNextFitCursor(int index);
+    
+    // Owner zone is notified when this area switches between full and non-full
+    void attachToZone(Zone* zone, int index);
+    
     // Statistics
     void updateOccupancyCount();
+    SlotStatusCounts getStatusCounts(KernelLevel level = KERNEL_AUTO) const;
     void displayAreaInfo() const;
 };
 
@@ -3,40 +3,82 @@
 
 #include "Enums.h"
 #include "StateValidator.h"
+#include "VehicleIdPool.h"
+#include "TimingWheel.h"
+
+const int MAX_REQUEST_PRIORITY = 15;
 
 class ParkingRequest {
 private:
     int requestId;
-    char* vehicleId;
+    VehicleHandle vehicle;              // Interned plate
+    const VehicleIdPool* vehiclePool;   // Resolves the plate for display
     int requestedZoneId;
     int allocatedSlotId;
+    int allocatedSlotHandle;    // SlotDirectory handle for O(1) release
     RequestState currentState;
     long long requestTime;
     long long allocationTime;
     long long occupiedTime;
     long long releaseTime;
     bool crossZoneAllocation;
+    bool queued;                // Waiting in a batch queue
+    TimerHandle expiryTimer;    // Pending no-show expiry (owned by ParkingSystem)
+    long long bookedDuration;   // Expected stay in seconds, 0 = system default
+    bool overstayFlagged;       // Overstay callback already fired for this stay
+    int priority;               // 0 (lowest) .. MAX_REQUEST_PRIORITY; orders waitlists
+    bool waitlisted;            // Waiting in its zone's waitlist
+    RequestClass requestClass;
+    bool classCharged;          // Counted in its slot zone's class-held counter
+    unsigned int requiredAttributes;    // SlotAttribute mask the slot must have
+    int slotCount;              // Adjacent slots needed in one area (buses, trailers); the run starts at the allocated slot
     
 public:
     // Constructors & Destructor
-    ParkingRequest(int id, const char* vehicle, int zone);
+    ParkingRequest(int id, VehicleHandle vehicleHandle, int zone, const VehicleIdPool* pool);
     ~ParkingRequest();
     
+    // Recycling (used by RequestTable)
+    void reset(int id, VehicleHandle vehicleHandle, int zone);
+    
     // Getters
     int getRequestId() const;
     const char* getVehicleId() const;
+    VehicleHandle getVehicleHandle() const;
     int getRequestedZoneId() const;
     int getAllocatedSlotId() const;
+    int getAllocatedSlotHandle() const;
     RequestState getState() const;
     long long getRequestTime() const;
     long long getAllocationTime() const;
     long long getOccupiedTime() const;
     long long getReleaseTime() const;
     bool isCrossZone() const;
+    bool isQueued() const;
+    void setQueued(bool value);
+    TimerHandle getExpiryTimer() const;
+    void setExpiryTimer(TimerHandle handle);
+    long long getBookedDuration() const;
+    void setBookedDuration(long long seconds);
+    bool isOverstayFlagged() const;
+    void setOverstayFlagged(bool value);
+    int getPriority() const;
+    void setPriority(int value);
+    bool isWaitlisted() const;
+    void setWaitlisted(bool value);
+    RequestClass getRequestClass() const;
+    void setRequestClass(RequestClass value);  // Raises priority to the class default
+    bool isClassCharged() const;
+    void setClassCharged(bool value);
+    unsigned int getRequiredAttributes() const;
+    void setRequiredAttributes(unsigned int mask);
+    int getSlotCount() const;
+    void setSlotCount(int count);
     
     // State Management
     bool setState(RequestState newState);
-    bool allocateSlot(int slotId, bool isCrossZone);
+    bool allocateSlot(int slotId, bool isCrossZone, int slotHandle = -1);
+    bool revertAllocation();    // Rollback only: ALLOCATED -> REQUESTED, slot cleared
     bool markOccupied();
     bool markReleased();
     bool cancel();
@@ -2,20 +2,25 @@
 #define PARKING_SLOT_H
 
 #include "Enums.h"
+#include "VehicleIdPool.h"
 #include <ctime>
 
+// Forward declarations
+class SlotTable;
+class ParkingArea;
+
+// Lightweight view over one row of its area's SlotTable.
+// All slot state lives in the table's contiguous columns.
 class ParkingSlot {
 private:
-    int slotId;
-    int areaId;
-    int zoneId;
-    SlotStatus status;
-    char* allocatedVehicleId;
-    long long allocationTime;
+    SlotTable* table;
+    int slotIndex;
+    
+    bool transitionTo(SlotStatus newStatus);
     
 public:
     // Constructors & Destructor
-    ParkingSlot(int id, int area, int zone);
+    ParkingSlot(SlotTable* owner, int index);
     ~ParkingSlot();
     
     // Getters
@@ -24,13 +29,23 @@ public:
     int getZoneId() const;
     SlotStatus getStatus() const;
     const char* getAllocatedVehicleId() const;
+    VehicleHandle getAllocatedVehicleHandle() const;
     bool isAvailable() const;
+    unsigned int getAttributes() const;
+    bool hasAttributes(unsigned int required) const;
     long long getAllocationTime() const;
+    int getSlotIndex() const;
+    int getSlotHandle() const;
+    ParkingArea* getArea() const;
+    void setSlotId(int id);
+    void setSlotHandle(int handle);
     
-    // State Management
+    // State Management (status writes go through the owner area's transitionSlot)
+    bool allocate(VehicleHandle vehicle);
     bool allocate(const char* vehicleId);
     bool release();
     bool setStatus(SlotStatus newStatus);
+    void setAttributes(unsigned int mask);     // Through the owner area, like status
     
     // Display
     void displayInfo() const;
@@ -10,76 +10,129 @@
 #include "LinkedList.h"
 #include "Queue.h"
 #include "DynamicArray.h"
+#include "SlotDirectory.h"
+#include "VehicleIndex.h"
+#include "RequestTable.h"
+#include "VehicleIdPool.h"
+#include "TimingWheel.h"
+#include "IndexedMinHeap.h"
+#include "ReservationCalendar.h"
+#include <mutex>
+#include <atomic>
 
 // Trip history entry
 struct TripHistory {
     int requestId;
-    char* vehicleId;
+    VehicleHandle vehicle;  // Interned plate
     int zoneId;
     long long startTime;
     long long endTime;
     bool completed;  // false if cancelled
     
-    TripHistory() : requestId(0), vehicleId(nullptr), zoneId(0), 
+    TripHistory() : requestId(0), vehicle(NO_VEHICLE), zoneId(0), 
                    startTime(0), endTime(0), completed(false) {}
+};
+
+// Advance booking of one slot in a zone for [startTime, endTime)
+struct Reservation {
+    int reservationId;
+    VehicleHandle vehicle;
+    int zoneId;
+    long long startTime;
+    long long endTime;
+    ReservationState state;
+    int slotHandle;         // Held slot once RESERVATION_HELD
+    int requestId;          // Request created at check-in
     
-    ~TripHistory() {
-        if (vehicleId != nullptr) {
-            delete[] vehicleId;
-        }
-    }
-    
-    TripHistory(const TripHistory& other) {
-        requestId = other.requestId;
-        zoneId = other.zoneId;
-        startTime = other.startTime;
-        endTime = other.endTime;
-        completed = other.completed;
-        
-        if (other.vehicleId != nullptr) {
-            int len = strlen(other.vehicleId);
-            vehicleId = new char[len + 1];
-            strcpy(vehicleId, other.vehicleId);
-        } else {
-            vehicleId = nullptr;
-        }
-    }
-    
-    TripHistory& operator=(const TripHistory& other) {
-        if (this != &other) {
-            if (vehicleId != nullptr) {
-                delete[] vehicleId;
-            }
-            
-            requestId = other.requestId;
-            zoneId = other.zoneId;
-            startTime = other.startTime;
-            endTime = other.endTime;
-            completed = other.completed;
-            
-            if (other.vehicleId != nullptr) {
-                int len = strlen(other.vehicleId);
-                vehicleId = new char[len + 1];
-                strcpy(vehicleId, other.vehicleId);
-            } else {
-                vehicleId = nullptr;
-            }
-        }
-        return *this;
-    }
+    Reservation() : reservationId(-1), vehicle(NO_VEHICLE), zoneId(0), startTime(0), endTime(0),
+                    state(RESERVATION_NONE), slotHandle(-1), requestId(-1) {}
 };
 
+// Overstay hook: fired once per stay, outside every system lock
+typedef void (*OverstayCallback)(int requestId, long long overdueSeconds, void* context);
+
 class ParkingSystem {
 private:
     DynamicArray<Zone*> zones;
-    DynamicArray<ParkingRequest*> requests;
+    VehicleIdPool vehiclePool;          // Interned plates shared by requests, slots and history
+    RequestTable requestTable;          // ID-indexed live requests + archived terminal records
     LinkedList<TripHistory> tripHistory;
+    SlotDirectory slotDirectory;
+    VehicleIndex activeRequestIndex;    // Vehicle handle -> live (non-terminal) request
+    OccupancyCounter cityOccupancy;     // Sum of the zone counters
+    Queue<ParkingRequest*> pendingRequests[REQUEST_CLASS_COUNT];  // One level per class, drained highest first
+    ZoneGraph zoneGraph;                // Zone ID index + compiled adjacency / fallback lists
     
     AllocationEngine* allocationEngine;
     RollbackManager* rollbackManager;
     AnalyticsEngine* analyticsEngine;
+    WorkStealingPool* workerPool;       // nullptr until startWorkerPool()
+    
+    // No-show expiry: one wheel timer (1 tick = 1 second) per ALLOCATED request
+    TimingWheel noShowWheel;
+    int noShowTimeout;                  // Seconds from allocation to expiry, 0 = off
+    std::atomic<long long> noShowCount;
+    
+    // Overstays: OCCUPIED requests keyed by expected exit time
+    IndexedMinHeap stayHeap;
+    long long defaultStayDuration;      // Seconds, used when a request has no booking
+    OverstayCallback overstayCallback;
+    void* overstayContext;
+    
+    // Waitlists: REQUESTED requests that found no slot, one heap per zone
+    // (ZoneGraph index), served when a slot frees up
+    DynamicArray<IndexedMinHeap*> waitlists;
+    bool waitlistEnabled;
+    std::atomic<long long> handoffCount;
+    
+    // Advance reservations. Calendars (ZoneGraph index) are created on a
+    // zone's first booking and guarded by that zone's shard lock.
+    static const int RESERVATION_BUCKET_SECONDS = 15 * 60;
+    static const int RESERVATION_BUCKETS = 90 * 24 * 4;    // 90-day horizon
+    DynamicArray<ReservationCalendar*> bookedCalendars;     // Every live booking: sets what can be sold
+    DynamicArray<ReservationCalendar*> pendingCalendars;    // Bookings with no slot held yet: walk-in holdback
+    DynamicArray<Reservation> reservations;                 // Indexed by reservation ID
+    IndexedMinHeap reservationStarts;   // BOOKED, keyed by the time to hold a slot
+    IndexedMinHeap reservationHolds;    // HELD, keyed by the end of the grace period
+    long long calendarOrigin;
+    int reservationHoldLead;            // Seconds before the start a slot is held
+    int reservationGrace;               // Seconds after the start a hold waits for check-in
     
-    int nextRequestId;
+    // Concurrency: slot state is sharded by zone (Zone::lock). Request-level
+    // state shares a few locks, always taken in the order
+    // request stripe -> zone shard -> registry / rollback log stripe / no-show wheel / stay heap /
+    // waitlists. The reservation lock comes before all of them.
+    static const int REQUEST_LOCK_STRIPES = 64;
+    std::mutex requestLocks[REQUEST_LOCK_STRIPES];  // Serialize operations on one request ID
+    mutable std::mutex registryLock;    // requestTable writes (lookups are lock-free), activeRequestIndex, vehiclePool, tripHistory
+    mutable std::mutex noShowLock;      // noShowWheel and every request's expiry handle (innermost)
+    mutable std::mutex stayLock;        // stayHeap (innermost)
+    mutable std::mutex waitlistLock;    // waitlists (innermost)
+    mutable std::mutex reservationLock; // reservations and their heaps; taken before any zone lock
+    
+    std::mutex& requestLockFor(int requestId);
+    bool verbose;                       // Per-request "created" / "allocated" console lines
+    std::atomic<int> runningActorSystems;   // ZoneActorSystems between start() and stop()
+    bool refusedWhileActorsRun(const char* operation) const;   // Debug builds: true (and reported) while actors own the slots
+    
+    // Terminal requests are logged and retired from the live table
+    void closeRequest(ParkingRequest* request, const TripHistory& trip);
+    bool reportIfRetired(int requestId);
+    bool cancelHeld(ParkingRequest* request, int& freedSlotHandle,
+                    bool zoneOwned = false);    // Caller holds the request's stripe lock
+    long long expectedExitTime(const ParkingRequest* request) const;
+    
+    static long long waitlistKey(const ParkingRequest* request);
+    bool joinWaitlist(ParkingRequest* request);     // Caller holds the request's stripe lock
+    void leaveWaitlist(ParkingRequest* request);
+    bool canFallBackTo(int fromIndex, int toIndex);
+    bool handOffToZone(int zoneIndex);              // No stripe lock held; takes the waiter's
+    void handOffFreedSlot(int slotHandle);
+    
+    void ensureCalendars(int zoneIndex);            // Caller holds the zone's shard lock
+    bool holdReservation(Reservation& reservation); // Caller holds reservationLock
+    void releaseHold(Reservation& reservation);     // Same
+    void dropBooking(Reservation& reservation);     // Same; BOOKED only
     
 public:
     // Constructor & Destructor
@@ -88,30 +141,108 @@ public:
     
     // Zone Management
     void addZone(Zone* zone);
+    bool setReservedCapacity(int zoneId, RequestClass requestClass, int slots);
+    bool setSlotAttributes(int slotId, unsigned int attributes);   // SlotAttribute mask
     Zone* getZoneById(int zoneId);
     int getZoneCount() const;
     
-    // Request Management
-    int createRequest(const char* vehicleId, int zoneId);
+    // Request Management (thread-safe: createRequest, processRequest, cancelRequest,
+    // markVehicleArrived and markVehicleExited may be called from many threads.
+    // Zone setup, batches, rollback and reports stay single-threaded.)
+    int createRequest(const char* vehicleId, int zoneId, RequestClass requestClass = CLASS_STANDARD);
     bool processRequest(int requestId);
-    bool cancelRequest(int requestId);
-    ParkingRequest* getRequestById(int requestId);
+    bool setRequiredAttributes(int requestId, unsigned int attributes);    // Before allocation
+    bool setRequiredSlots(int requestId, int slotCount);   // Adjacent slots in one area (buses, trailers)
+    bool cancelRequest(int requestId, bool zoneOwned = false);
+    void setVerbose(bool enabled);      // false keeps console output off the gateway path; errors still print
+    bool isVerbose() const;
+    void setZoneActorsRunning(bool running);    // Called by ZoneActorSystem::start() / stop()
+    
+    // Batch Processing (gate-open surges)
+    int submitRequest(const char* vehicleId, int zoneId, RequestClass requestClass = CLASS_STANDARD);
+    bool enqueueRequest(int requestId);
+    BatchAllocationResult processPendingRequests();
+    int getPendingCount() const;
     
-    // Slot Operations
+    // Worker Pool (zone-parallel batches and zone reports)
+    bool startWorkerPool(int threads);
+    void stopWorkerPool();
+    WorkStealingPool* getWorkerPool();
+    ParkingRequest* getRequestById(int requestId);     // Lock-free
+    const ArchivedRequest* getArchivedRequest(int requestId) const;
+    RequestTable* getRequestTable();
+    
+    // Slot Operations. zoneOwned: the caller is the ZoneActorSystem actor
+    // owning the request's slot zone, so the slot is released without the
+    // shard lock and no waitlist handoff runs.
     bool markVehicleArrived(int requestId);
-    bool markVehicleExited(int requestId);
+    bool markVehicleExited(int requestId, bool zoneOwned = false);
+    int getRequestSlot(int requestId, RequestState& state);    // Slot handle (-1 = none) and state, read together
+    
+    // No-show Expiry (an ALLOCATED request whose vehicle has not arrived by
+    // allocation time + timeout is cancelled and its slot freed)
+    void armNoShowTimer(ParkingRequest* request);   // Called on every allocation
+    void disarmNoShowTimer(ParkingRequest* request);    // Arrival, cancel, and rolled-back allocations
+    int expireNoShows(long long now);               // Advances the wheel; returns requests cancelled
+    void setNoShowTimeout(int seconds);
+    int getNoShowTimeout() const;
+    long long getNoShowCount() const;
+    int getPendingNoShowTimers() const;
+    
+    // Overstays (OCCUPIED past occupied time + booked or default duration)
+    bool setBookedDuration(int requestId, long long seconds);
+    void setDefaultStayDuration(long long seconds);
+    long long getDefaultStayDuration() const;
+    void setOverstayCallback(OverstayCallback callback, void* context);
+    int checkOverstays(long long now);      // Fires the callback for new overstays; returns how many
+    int collectOverstays(long long now, DynamicArray<int>& requestIds);     // Every current overstay
+    int getTrackedStayCount() const;
+    
+    // Waitlists (off by default): a request processRequest cannot place waits
+    // in its zone's waitlist; exits, cancels, no-show expiry and rollback hand
+    // freed slots to the best waiter of that zone, then of nearby zones
+    void setWaitlistEnabled(bool enabled);
+    bool isWaitlistEnabled() const;
+    bool setRequestPriority(int requestId, int priority);  // 0 .. MAX_REQUEST_PRIORITY, higher served first
+    int serveWaitlists();                   // Hands every free slot to waiters; returns how many
+    int getWaitlistLength(int zoneId) const;
+    long long getHandoffCount() const;
+    
+    // Advance Reservations (zone level, 15-minute buckets, 90-day horizon).
+    // A slot is held (SLOT_RESERVED) shortly before each booking starts; until
+    // then walk-ins are only admitted if they leave room for every booking
+    // that starts during their expected stay.
+    int reserve(const char* vehicleId, int zoneId, long long startTime, long long endTime);
+    bool isZoneAvailable(int zoneId, long long startTime, long long endTime);   // O(log buckets)
+    int advanceReservations(long long now);     // Holds due slots, expires unclaimed holds
+    int checkInReservation(int reservationId);  // Returns the ALLOCATED request's ID, -1 on failure
+    bool cancelReservation(int reservationId);
+    ReservationState getReservationState(int reservationId) const;
+    void setReservationHoldWindow(int leadSeconds, int graceSeconds);
+    int getReservationHoldback(Zone* zone, long long from, long long until);   // Under the zone's shard lock
     
-    // Rollback
+    // Rollback (a rolled-back request is REQUESTED again, with no slot, timer or class charge)
     bool rollbackOperations(int k);
+    bool undoAllocation(int requestId, int slotId);     // False if the request no longer holds slotId
     
     // Utility - needed by other classes
+    bool releaseSlot(int slotHandle);   // Under the owning zone's shard lock
+    bool releaseRequestSlot(ParkingRequest* request, bool zoneOwned = false);  // Same, and refunds the request's class
     ParkingSlot* findSlotById(int slotId);
+    ParkingSlot* findSlotByHandle(int slotHandle);
+    SlotDirectory* getSlotDirectory();
+    ZoneGraph* getZoneGraph();
     ParkingRequest* findRequestByVehicle(const char* vehicleId);
+    ParkingRequest* findRequestByVehicle(VehicleHandle vehicle);
+    VehicleIdPool* getVehiclePool();
+    int getActiveVehicleCount() const;
     
     // Analytics
     float getAverageParkingDuration();
     float getZoneUtilization(int zoneId);
     float getSystemUtilization();
+    const OccupancyCounter* getCityOccupancy() const;
+    SlotStatusCounts auditSlotStatuses(KernelLevel level = KERNEL_AUTO);
     int getPeakUsageZone();
     float getCancelledRatio();
     int getTotalRequests() const;
@@ -120,6 +251,8 @@ public:
     
     // Enhanced Analytics via AnalyticsEngine
     AnalyticsEngine* getAnalyticsEngine();
+    AllocationEngine* getAllocationEngine();
+    RollbackManager* getRollbackManager();
     void generateAnalyticsSummary();
     void generateDetailedAnalytics();
     void generateZoneReport(int zoneId);
@@ -0,0 +1,96 @@
+#ifndef REQUEST_TABLE_H
+#define REQUEST_TABLE_H
+
+#include "ParkingRequest.h"
+#include "DynamicArray.h"
+#include <atomic>
+
+// Compact record kept for a request once it reaches RELEASED or CANCELLED
+struct ArchivedRequest {
+    int requestId;
+    int requestedZoneId;
+    int allocatedSlotId;
+    RequestState finalState;
+    bool crossZoneAllocation;
+    long long requestTime;
+    long long occupiedTime;
+    long long releaseTime;
+    VehicleHandle vehicle;      // Interned plate
+
+    ArchivedRequest() : requestId(0), requestedZoneId(0), allocatedSlotId(-1),
+                        finalState(RELEASED), crossZoneAllocation(false),
+                        requestTime(0), occupiedTime(0), releaseTime(0),
+                        vehicle(NO_VEHICLE) {}
+
+    long long getParkingDuration() const;
+    void displayRequestInfo(const VehicleIdPool* pool) const;
+};
+
+// ID-indexed request slab.
+// Request IDs are minted sequentially, so the entry for an ID sits at
+// (requestId - firstRequestId): lookup is a subtraction plus a bounds check.
+// Entries live in fixed-size chunks that never move, so getLive() takes no
+// lock: create() and retire() run under the owner's registry lock and publish
+// through entryCount and the entries' live pointers.
+// Terminal requests are retired into fixed-size archive chunks (records never
+// move) and their ParkingRequest objects go on a free list for reuse, so live
+// request memory is bounded by the peak number of active requests.
+class RequestTable {
+private:
+    struct Entry {
+        std::atomic<ParkingRequest*> live;  // nullptr once retired
+        int archiveIndex;                   // -1 while live
+    };
+
+    static const int ENTRY_CHUNK_SIZE = 1024;
+    static const int ARCHIVE_CHUNK_SIZE = 1024;
+
+    // A full directory is replaced by a larger copy; readers may still hold
+    // the old one, so replaced directories are freed only by the destructor
+    std::atomic<Entry**> entryChunks;
+    int entryChunkCapacity;
+    std::atomic<int> entryCount;
+    DynamicArray<Entry**> replacedDirectories;
+    int firstRequestId;
+
+    ArchivedRequest** archiveChunks;
+    int chunkCapacity;
+    int archivedCount;
+
+    DynamicArray<ParkingRequest*> freeList;
+    int liveCount;
+
+    const VehicleIdPool* vehiclePool;
+
+    Entry* getEntry(int requestId) const;
+    ArchivedRequest* archiveSlot(int archiveIndex) const;
+
+public:
+    // Constructor & Destructor
+    RequestTable(const VehicleIdPool* pool, int firstId = 1);
+    ~RequestTable();
+
+    RequestTable(const RequestTable& other) = delete;
+    RequestTable& operator=(const RequestTable& other) = delete;
+
+    // Lifecycle
+    ParkingRequest* create(VehicleHandle vehicle, int zoneId);
+    bool retire(ParkingRequest* request);
+
+    // Lookup
+    ParkingRequest* getLive(int requestId) const;      // Lock-free
+    const ArchivedRequest* getArchived(int requestId) const;
+    bool contains(int requestId) const;
+    int getNextRequestId() const;
+
+    // Statistics
+    int getTotalCount() const;
+    int getLiveCount() const;
+    int getArchivedCount() const;
+    int getRecycledCount() const;
+
+    // Display (ID order, live and archived)
+    void displayAll() const;
+};
+
+#endif // REQUEST_TABLE_H
@@ -0,0 +1,40 @@
+#ifndef RESERVATION_CALENDAR_H
+#define RESERVATION_CALENDAR_H
+
+// Booking counts per fixed time bucket over a finite horizon, stored as a
+// segment tree with lazy range-add, so booking a window and asking for the
+// busiest bucket in a window are both O(log buckets) however many bookings
+// overlap. A window [start, end) covers every bucket it touches.
+class ReservationCalendar {
+private:
+    long long origin;           // Start of bucket 0
+    int bucketSeconds;
+    int bucketCount;
+    int leafCount;              // bucketCount rounded up to a power of two
+    int* maxCount;              // Busiest bucket under each node (children's max + own pending add)
+    int* pendingAdd;            // Range adds not pushed below this node
+
+    void add(int node, int nodeLow, int nodeHigh, int low, int high, int delta);
+    int query(int node, int nodeLow, int nodeHigh, int low, int high) const;
+
+public:
+    // Constructor & Destructor
+    ReservationCalendar(long long originTime, int bucketSeconds, int bucketCount);
+    ~ReservationCalendar();
+
+    ReservationCalendar(const ReservationCalendar& other) = delete;
+    ReservationCalendar& operator=(const ReservationCalendar& other) = delete;
+
+    // Windows must end after they start and lie inside the horizon
+    bool covers(long long start, long long end) const;
+    bool addBooking(long long start, long long end, int delta);
+    int getMaxBooked(long long start, long long end) const;    // Clipped to the horizon
+
+    // Horizon
+    long long getOrigin() const;
+    long long getHorizonEnd() const;
+    int getBucketSeconds() const;
+    int getBucketCount() const;
+};
+
+#endif // RESERVATION_CALENDAR_H
@@ -2,26 +2,46 @@
 #define ROLLBACK_MANAGER_H
 
 #include "Stack.h"
+#include <atomic>
+#include <mutex>
 
 // Forward declarations
 class ParkingSystem;
 class ParkingSlot;
 class ParkingRequest;
 
+// Allocation log for undo. Allocating threads log into one of LOG_STRIPES
+// stacks picked by request ID, each with its own lock, so gateways working on
+// different requests do not queue on one log. Every operation takes a global
+// sequence number; rollback pops the highest across the stripes, so undo order
+// is still newest first.
 class RollbackManager {
 private:
-    Stack operationStack;
+    static const int LOG_STRIPES = 16;
+    
+    struct LogStripe {
+        Stack operations;
+        std::mutex lock;
+    };
+    
+    LogStripe stripes[LOG_STRIPES];
+    std::atomic<long long> nextSequence;
+    std::atomic<int> depth;
     ParkingSystem* system;
     
+    LogStripe& stripeFor(int requestId);
+    int newestStripe() const;       // Stripe whose top is the latest operation, -1 if all empty
+    
 public:
     // Constructor
     RollbackManager(ParkingSystem* sys);
     ~RollbackManager();
     
     // Operation Logging
-    void logAllocation(int slotId, const char* vehicleId, int prevState);
+    void logAllocation(const ParkingRequest* request, int prevState);     // After allocateSlot
+    void logAllocationBatch(ParkingRequest* const* requests, int count, int prevState);
     
-    // Rollback
+    // Rollback (single-threaded, like batch draining)
     bool rollback(int k);
     bool canRollback() const;
     int getRollbackDepth() const;
@@ -0,0 +1,67 @@
+#ifndef SLOT_DIRECTORY_H
+#define SLOT_DIRECTORY_H
+
+#include "DynamicArray.h"
+
+// Forward declarations
+class ParkingSlot;
+class ParkingArea;
+class Zone;
+
+// Directory entry: everything needed to act on a slot without searching
+struct SlotDirectoryEntry {
+    ParkingSlot* slot;
+    ParkingArea* area;
+    Zone* zone;
+
+    SlotDirectoryEntry() : slot(nullptr), area(nullptr), zone(nullptr) {}
+};
+
+// Flat city-wide slot directory.
+// Every registered slot gets a dense handle (0, 1, 2, ...) that indexes the
+// entry array directly. External slot IDs are kept and resolved to handles
+// through an open-addressing hash table, so both lookups are O(1).
+// A slot whose external ID is already taken is re-keyed to a fresh ID
+// above every registered one, so IDs stay unique city-wide.
+class SlotDirectory {
+private:
+    DynamicArray<SlotDirectoryEntry> entries;   // handle -> entry
+
+    // External slot ID -> handle (linear probing, capacity is a power of two)
+    int* idKeys;
+    int* idHandles;
+    int idCapacity;
+    int idCount;
+    int maxSlotId;
+
+    static const int EMPTY_KEY = -1;
+
+    int probeIndex(int slotId) const;
+    void growIdTable();
+    bool insertId(int slotId, int handle);
+
+public:
+    // Constructor & Destructor
+    SlotDirectory();
+    ~SlotDirectory();
+
+    SlotDirectory(const SlotDirectory& other) = delete;
+    SlotDirectory& operator=(const SlotDirectory& other) = delete;
+
+    // Registration
+    int registerSlot(ParkingSlot* slot, ParkingArea* area, Zone* zone);
+    void registerArea(ParkingArea* area, Zone* zone);
+
+    // Lookup
+    int findHandle(int slotId) const;
+    ParkingSlot* findSlotById(int slotId);
+    ParkingSlot* getSlot(int handle);
+    ParkingArea* getArea(int handle);
+    Zone* getZone(int handle);
+    const SlotDirectoryEntry* getEntry(int handle) const;
+
+    // Statistics
+    int getSlotCount() const;
+};
+
+#endif // SLOT_DIRECTORY_H
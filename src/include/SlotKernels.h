@@ -0,0 +1,65 @@
+#ifndef SLOT_KERNELS_H
+#define SLOT_KERNELS_H
+
+#include "Enums.h"
+
+// Instruction set used by the slot status kernels
+enum KernelLevel {
+    KERNEL_AUTO,      // Best level supported by the running CPU
+    KERNEL_SCALAR,
+    KERNEL_SSE2,
+    KERNEL_AVX2
+};
+
+// Per-status slot counts
+struct SlotStatusCounts {
+    int available;
+    int occupied;
+    int reserved;
+    int maintenance;
+
+    SlotStatusCounts() : available(0), occupied(0), reserved(0), maintenance(0) {}
+
+    int total() const { return available + occupied + reserved + maintenance; }
+
+    int get(SlotStatus status) const {
+        switch (status) {
+            case SLOT_AVAILABLE: return available;
+            case SLOT_OCCUPIED: return occupied;
+            case SLOT_RESERVED: return reserved;
+            case SLOT_MAINTENANCE: return maintenance;
+            default: return 0;
+        }
+    }
+
+    void adjust(SlotStatus status, int delta) {
+        switch (status) {
+            case SLOT_AVAILABLE: available += delta; break;
+            case SLOT_OCCUPIED: occupied += delta; break;
+            case SLOT_RESERVED: reserved += delta; break;
+            case SLOT_MAINTENANCE: maintenance += delta; break;
+        }
+    }
+};
+
+// Vectorized kernels over a contiguous SlotStatus byte column (see SlotTable).
+// AVX2 and SSE2 paths are compiled with per-function target attributes and
+// chosen at runtime by CPU feature detection; the scalar path is the fallback
+// and the reference for the others.
+class SlotKernels {
+public:
+    // CPU Feature Detection
+    static KernelLevel getBestLevel();
+    static bool isSupported(KernelLevel level);
+    static const char* getLevelName(KernelLevel level);
+
+    // Kernels (index results are -1 when nothing matches)
+    static SlotStatusCounts countStatuses(const unsigned char* statuses, int count,
+                                          KernelLevel level = KERNEL_AUTO);
+    static int findFirstAvailable(const unsigned char* statuses, int count,
+                                  KernelLevel level = KERNEL_AUTO);
+    static int findFirstNotMaintenance(const unsigned char* statuses, int count,
+                                       KernelLevel level = KERNEL_AUTO);
+};
+
+#endif // SLOT_KERNELS_H
@@ -0,0 +1,81 @@
+#ifndef SLOT_TABLE_H
+#define SLOT_TABLE_H
+
+#include "Enums.h"
+#include "SlotKernels.h"
+#include "VehicleIdPool.h"
+#include <cstddef>
+
+// Forward declarations
+class ParkingSlot;
+class ParkingArea;
+
+// Structure-of-arrays slot storage for one parking area.
+// All columns (and the ParkingSlot views over them) are carved out of a
+// single arena allocation, each column aligned to a cache line, so status
+// scans touch one contiguous byte array instead of chasing slot pointers.
+class SlotTable {
+private:
+    unsigned char* arena;
+    size_t arenaBytes;
+    int slotCount;
+    int areaId;
+    int zoneId;
+    ParkingArea* ownerArea;
+    VehicleIdPool* vehiclePool;     // Shared plate pool (nullptr until registered)
+
+    // Columns
+    unsigned char* statuses;        // SlotStatus stored as one byte per slot
+    unsigned char* attributes;      // SlotAttribute mask per slot
+    long long* allocationTimes;
+    VehicleHandle* vehicleHandles;  // Interned plates, NO_VEHICLE when empty
+    int* slotIds;                   // External slot IDs
+    int* slotHandles;               // SlotDirectory handles (-1 if unregistered)
+    ParkingSlot* views;             // Lightweight ParkingSlot views, one per slot
+
+    static size_t alignUp(size_t offset);
+
+public:
+    static const size_t COLUMN_ALIGNMENT = 64;
+
+    // Constructor & Destructor
+    SlotTable(ParkingArea* owner, int area, int zone, int count, int firstSlotId);
+    ~SlotTable();
+
+    SlotTable(const SlotTable& other) = delete;
+    SlotTable& operator=(const SlotTable& other) = delete;
+
+    // Table Info
+    int getSlotCount() const;
+    int getAreaId() const;
+    int getZoneId() const;
+    ParkingArea* getOwnerArea() const;
+    size_t getArenaBytes() const;
+    ParkingSlot* getView(int index);
+    VehicleIdPool* getVehiclePool() const;
+    void setVehiclePool(VehicleIdPool* pool);
+
+    // Column Access
+    SlotStatus getStatus(int index) const;
+    void setStatus(int index, SlotStatus status);
+    unsigned int getAttributes(int index) const;
+    void setAttributes(int index, unsigned int mask);
+    long long getAllocationTime(int index) const;
+    void setAllocationTime(int index, long long time);
+    VehicleHandle getVehicleHandle(int index) const;
+    void setVehicleHandle(int index, VehicleHandle vehicle);
+    const char* getVehicleId(int index) const;
+    int getSlotId(int index) const;
+    void setSlotId(int index, int id);
+    int getSlotHandle(int index) const;
+    void setSlotHandle(int index, int handle);
+    const unsigned char* getStatusArray() const;
+
+    // Scans (vectorized via SlotKernels)
+    int countStatus(SlotStatus status) const;
+    SlotStatusCounts getStatusCounts(KernelLevel level = KERNEL_AUTO) const;
+    int findFirstAvailable(KernelLevel level = KERNEL_AUTO) const;
+    int findFirstNotMaintenance(KernelLevel level = KERNEL_AUTO) const;
+};
+
+#endif // SLOT_TABLE_H
@@ -1,65 +1,23 @@
 #ifndef STACK_H
 #define STACK_H
 
+#include "VehicleIdPool.h"
 #include <iostream>
-#include <cstring>
 
 // Rollback operation structure
 struct RollbackOperation {
     int slotId;
+    int slotCount;             // Adjacent slots allocated together, starting at slotId
     bool previousAvailability;
     int previousRequestState;  // Store as int to avoid circular dependency
-    char* vehicleId;
+    VehicleHandle vehicle;     // Interned plate (no per-operation copy)
+    int requestId;             // Request that received the slot
     long long timestamp;
+    long long sequence;        // Global log order (RollbackManager stripes are merged by it)
     
-    RollbackOperation() : slotId(-1), previousAvailability(true), 
-                         previousRequestState(0), vehicleId(nullptr), timestamp(0) {}
-    
-    ~RollbackOperation() {
-        if (vehicleId != nullptr) {
-            delete[] vehicleId;
-        }
-    }
-    
-    // Copy constructor
-    RollbackOperation(const RollbackOperation& other) {
-        slotId = other.slotId;
-        previousAvailability = other.previousAvailability;
-        previousRequestState = other.previousRequestState;
-        timestamp = other.timestamp;
-        
-        if (other.vehicleId != nullptr) {
-            int len = strlen(other.vehicleId);
-            vehicleId = new char[len + 1];
-            strcpy(vehicleId, other.vehicleId);
-        } else {
-            vehicleId = nullptr;
-        }
-    }
-    
-    // Assignment operator
-    RollbackOperation& operator=(const RollbackOperation& other) {
-        if (this != &other) {
-            // Clean up existing vehicleId
-            if (vehicleId != nullptr) {
-                delete[] vehicleId;
-            }
-            
-            slotId = other.slotId;
-            previousAvailability = other.previousAvailability;
-            previousRequestState = other.previousRequestState;
-            timestamp = other.timestamp;
-            
-            if (other.vehicleId != nullptr) {
-                int len = strlen(other.vehicleId);
-                vehicleId = new char[len + 1];
-                strcpy(vehicleId, other.vehicleId);
-            } else {
-                vehicleId = nullptr;
-            }
-        }
-        return *this;
-    }
+    RollbackOperation() : slotId(-1), slotCount(1), previousAvailability(true), 
+                         previousRequestState(0), vehicle(NO_VEHICLE), requestId(-1), timestamp(0),
+                         sequence(0) {}
 };
 
 class Stack {
@@ -75,6 +33,7 @@ public:
     ~Stack();
     
     void push(const RollbackOperation& operation);
+    void reserve(int additional);
     RollbackOperation pop();
     RollbackOperation peek() const;
     bool isEmpty() const;
@@ -0,0 +1,79 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include "DynamicArray.h"
+
+// Timer handle: node index in the low 32 bits, node generation in the high
+// 32 bits, so a handle kept after its timer fired or was cancelled goes stale
+// instead of hitting the node's next owner
+typedef long long TimerHandle;
+const TimerHandle NO_TIMER = -1;
+
+// A timer reported by advance()
+struct ExpiredTimer {
+    TimerHandle handle;
+    int payload;
+
+    ExpiredTimer() : handle(NO_TIMER), payload(0) {}
+};
+
+// Hierarchical timing wheel (4 levels x 256 buckets, one tick per level-0 bucket).
+// A timer sits in the lowest level whose span covers its distance from the
+// current tick; when a lower level wraps, the matching bucket one level up is
+// cascaded down. Timers are pooled nodes on intrusive doubly-linked bucket
+// lists, so schedule and cancel are O(1) and advancing costs one bucket per
+// tick plus each timer's (at most 3) cascades. Not thread-safe: the owner locks.
+class TimingWheel {
+private:
+    static const int LEVELS = 4;
+    static const int BUCKET_BITS = 8;
+    static const int BUCKETS = 1 << BUCKET_BITS;
+    static const int BUCKET_MASK = BUCKETS - 1;
+
+    struct TimerNode {
+        long long deadline;
+        int payload;
+        int next;               // Bucket list, or free list when unused
+        int prev;
+        int bucket;             // level * BUCKETS + index, -1 when free
+        unsigned int generation;
+
+        TimerNode() : deadline(0), payload(0), next(-1), prev(-1), bucket(-1), generation(0) {}
+    };
+
+    DynamicArray<TimerNode> nodes;
+    int heads[LEVELS * BUCKETS];    // First node of every bucket, -1 = empty
+    int freeHead;
+    int activeCount;
+    long long currentTick;
+
+    int allocateNode();
+    void freeNode(int node);
+    void link(int node);            // Into the bucket for its deadline
+    void unlink(int node);
+    void cascade(int level);        // Re-file the current bucket of a level one step down
+    int resolve(TimerHandle handle) const;
+
+public:
+    // Constructor & Destructor
+    TimingWheel(long long startTick = 0);
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel& other) = delete;
+    TimingWheel& operator=(const TimingWheel& other) = delete;
+
+    // Timers (deadlines at or before the current tick fire on the next tick)
+    TimerHandle schedule(long long deadline, int payload);
+    bool cancel(TimerHandle handle);    // false if it already fired or was cancelled
+    bool isPending(TimerHandle handle) const;
+
+    // Moves the clock to now and appends every timer that came due
+    int advance(long long now, DynamicArray<ExpiredTimer>& expired);
+
+    // Statistics
+    long long getCurrentTick() const;
+    int getActiveCount() const;
+    int getNodeCapacity() const;
+};
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,58 @@
+#ifndef VEHICLE_ID_POOL_H
+#define VEHICLE_ID_POOL_H
+
+#include "DynamicArray.h"
+#include <cstddef>
+
+// Compact 32-bit handle for an interned vehicle plate
+typedef unsigned int VehicleHandle;
+const VehicleHandle NO_VEHICLE = 0;
+
+// Interning pool for vehicle plates.
+// Each distinct plate is copied once into fixed-size character chunks (so the
+// returned strings never move) and gets a dense handle starting at 1.
+// Requests, slots, trip history and rollback entries store handles instead
+// of owned copies; an open-addressing table maps plates back to handles.
+class VehicleIdPool {
+private:
+    static const int CHUNK_BYTES = 16 * 1024;
+
+    // String storage
+    char** chunks;
+    int chunkCount;
+    int chunkCapacity;
+    int chunkUsed;              // Bytes used in the last chunk
+    size_t bytesUsed;
+
+    // Handle -> string / hash (index 0 is NO_VEHICLE)
+    DynamicArray<const char*> strings;
+    DynamicArray<unsigned int> hashes;
+
+    // Plate -> handle (linear probing, capacity is a power of two)
+    VehicleHandle* table;
+    int tableCapacity;
+
+    static unsigned int hashPlate(const char* vehicleId);
+    int findSlot(const char* vehicleId, unsigned int hash) const;
+    const char* storeString(const char* vehicleId, int length);
+    void growTable();
+
+public:
+    // Constructor & Destructor
+    VehicleIdPool();
+    ~VehicleIdPool();
+
+    VehicleIdPool(const VehicleIdPool& other) = delete;
+    VehicleIdPool& operator=(const VehicleIdPool& other) = delete;
+
+    // Interning
+    VehicleHandle intern(const char* vehicleId);
+    VehicleHandle find(const char* vehicleId) const;
+    const char* getString(VehicleHandle handle) const;
+
+    // Statistics
+    int getSize() const;
+    size_t getBytesUsed() const;
+};
+
+#endif // VEHICLE_ID_POOL_H
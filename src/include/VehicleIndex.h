@@ -0,0 +1,58 @@
+#ifndef VEHICLE_INDEX_H
+#define VEHICLE_INDEX_H
+
+#include "VehicleIdPool.h"
+
+// Forward declaration
+class ParkingRequest;
+
+// One bucket: interned plate plus the active request (nullptr = empty)
+struct VehicleIndexBucket {
+    VehicleHandle vehicle;
+    ParkingRequest* request;
+
+    VehicleIndexBucket() : vehicle(NO_VEHICLE), request(nullptr) {}
+};
+
+// Open-addressing hash index: vehicle handle -> currently active request.
+// Keys are the VehicleIdPool handles requests already carry, so lookups
+// compare integers and never touch plate strings (callers holding a plate
+// resolve it with VehicleIdPool::find first). Linear probing over a flat
+// bucket array; deletion uses backward shifting, so there are no tombstones
+// and probe chains never degrade over time.
+//
+// A plate may have more than one live request (a new one created before the
+// old one ends); each gets its own bucket, lookups return the newest, and
+// removing one leaves the others indexed.
+class VehicleIndex {
+private:
+    VehicleIndexBucket* buckets;
+    int capacity;               // Always a power of two
+    int count;                  // Indexed requests
+    int vehicleCount;           // Distinct vehicles among them
+
+    int idealBucket(VehicleHandle vehicle) const;
+    int findRequestBucket(const ParkingRequest* request) const;    // -1 if not indexed
+    int countVehicle(VehicleHandle vehicle) const;
+    void grow();
+
+public:
+    // Constructor & Destructor
+    VehicleIndex(int initialCapacity = 64);
+    ~VehicleIndex();
+
+    VehicleIndex(const VehicleIndex& other) = delete;
+    VehicleIndex& operator=(const VehicleIndex& other) = delete;
+
+    // Index Maintenance
+    void insert(ParkingRequest* request);
+    bool remove(ParkingRequest* request);
+    void clear();
+
+    // Lookup
+    ParkingRequest* find(VehicleHandle vehicle) const;     // Newest live request of the plate
+    int getSize() const;                                    // Distinct vehicles
+    int getRequestCount() const;
+};
+
+#endif // VEHICLE_INDEX_H
@@ -0,0 +1,80 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+class WorkStealingPool;
+
+// Unit of work: a function pointer plus caller-owned context (no allocation per task)
+typedef void (*PoolTaskFunction)(void* context, WorkStealingPool* pool, int worker);
+
+struct PoolTask {
+    PoolTaskFunction run;
+    void* context;
+
+    PoolTask() : run(nullptr), context(nullptr) {}
+};
+
+// Fixed-size worker pool with one task deque per worker.
+// A worker pops its own deque from the bottom (newest first, cache-warm
+// follow-ups) and, when empty, steals from the top of the others (oldest first),
+// so a burst queued on one worker spreads across idle ones. Each deque has its
+// own short lock; owners and thieves only meet on the deque being stolen from.
+class WorkStealingPool {
+private:
+    struct WorkerDeque {
+        std::mutex lock;
+        PoolTask* tasks;        // Circular buffer, live range [top, bottom)
+        int capacity;
+        int top;
+        int bottom;
+
+        WorkerDeque();
+        ~WorkerDeque();
+        void pushBottom(const PoolTask& task);
+        bool popBottom(PoolTask& task);
+        bool stealTop(PoolTask& task);
+    };
+
+    int workerCount;
+    WorkerDeque* deques;
+    std::thread* workers;
+
+    std::atomic<bool> stopping;
+    std::atomic<int> queuedTasks;       // Sitting in a deque
+    std::atomic<int> pendingTasks;      // Queued or running
+    std::atomic<unsigned int> nextDeque;    // Round-robin target for external submits
+    std::atomic<long long> executedCount;
+    std::atomic<long long> stealCount;
+
+    std::mutex sleepLock;
+    std::condition_variable workAvailable;
+    std::condition_variable allIdle;
+
+    void enqueue(int deque, const PoolTask& task);
+    bool findTask(int worker, PoolTask& task);
+    void workerLoop(int worker);
+
+public:
+    // Constructor & Destructor
+    WorkStealingPool(int threads);
+    ~WorkStealingPool();    // Finishes queued work, then joins
+
+    WorkStealingPool(const WorkStealingPool& other) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool& other) = delete;
+
+    // Scheduling
+    void submit(PoolTaskFunction run, void* context);               // Any thread
+    void spawn(int worker, PoolTaskFunction run, void* context);    // From inside a task: follow-up on this worker
+    void waitIdle();        // Blocks until every task (and its follow-ups) finished; not from a worker
+
+    // Statistics
+    int getWorkerCount() const;
+    long long getExecutedCount() const;
+    long long getStealCount() const;
+};
+
+#endif // WORK_STEALING_POOL_H
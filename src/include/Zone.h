@@ -3,6 +3,12 @@
 
 #include "ParkingArea.h"
 #include "DynamicArray.h"
+#include "Bitmap.h"
+#include "SlotDirectory.h"
+#include "ZoneGraph.h"
+#include "Enums.h"
+#include <mutex>
+#include <atomic>
 
 class Zone {
 private:
@@ -10,6 +16,29 @@ private:
     char* zoneName;
     DynamicArray<ParkingArea*> areas;
     DynamicArray<int> adjacentZoneIds;
+    DynamicArray<int> adjacentZoneWeights;  // Edge cost to adjacentZoneIds[i] (default 1)
+    Bitmap areasWithCapacity;   // Bit i set when areas[i] has at least one free slot
+    SlotSearchMode searchMode;
+    SlotDirectory* directory;   // City-wide directory this zone's slots are registered in
+    VehicleIdPool* vehiclePool; // City-wide plate pool handed to each area's slot table
+    OccupancyCounter occupancy; // Sum of the area counters; parent is the city counter
+    ZoneGraph* graph;           // Marked dirty when adjacency changes
+    std::mutex shardLock;       // Guards this zone's slots, bitmaps and counters
+    int areaCursor;             // Last area a round-robin claim used (under shardLock)
+    
+    // Priority class capacity: slots held back per class, and slots each
+    // class currently holds here (changed under shardLock, read lock-free)
+    int classReserve[REQUEST_CLASS_COUNT];
+    std::atomic<int> classHeld[REQUEST_CLASS_COUNT];
+    
+    // Negative cache: per required-attribute mask, the shortest run a search
+    // here found no room for, packed as (freeEpoch << 16 | length). Any slot
+    // turning free, or gaining attributes, bumps freeEpoch and so voids every
+    // entry at once.
+    std::atomic<long long> freeEpoch;
+    std::atomic<long long> missCache[1 << SLOT_ATTRIBUTE_COUNT];
+    
+    void registerArea(ParkingArea* area);
     
 public:
     // Constructors & Destructor
@@ -23,20 +52,55 @@ public:
     int getTotalSlots() const;
     int getOccupiedSlots() const;
     float getUtilization() const;
+    OccupancyCounter* getOccupancy();
+    SlotStatusCounts getStatusCounts(KernelLevel level = KERNEL_AUTO) const;
     
     // Area Management
     void addParkingArea(ParkingArea* area);
     ParkingArea* getAreaById(int areaId);
     ParkingArea* getAreaByIndex(int index);
+    void onAreaCapacityChanged(int areaIndex, bool hasCapacity);
+    void attachToSystem(SlotDirectory* slotDirectory, VehicleIdPool* pool,
+                        OccupancyCounter* cityOccupancy, ZoneGraph* zoneGraph);
+    int getAreasWithCapacityCount() const;
+    int findNextAreaWithCapacity(int fromIndex) const;     // -1 if none at or after fromIndex
+    int getAreaCursor() const;
+    void setAreaCursor(int index);
     
     // Adjacency Management
-    void addAdjacentZone(int zoneId);
+    void addAdjacentZone(int zoneId, int weight = 1);
     bool isAdjacentTo(int zoneId) const;
     int getAdjacentZoneCount() const;
     int getAdjacentZone(int index) const;
+    int getAdjacentZoneWeight(int index) const;
     
     // Slot Allocation
-    ParkingSlot* findAvailableSlot();
+    ParkingSlot* findAvailableSlot(unsigned int required = 0);     // required: SlotAttribute mask
+    int collectAvailableSlots(ParkingSlot** out, int maxCount, unsigned int required = 0);
+    int countAvailableSlots(unsigned int required = 0) const;    // Under the shard lock
+    ParkingSlot* findAvailableRun(int length, unsigned int required = 0);  // First slot of the run
+    void setSlotSearchMode(SlotSearchMode mode);
+    
+    // Class Reserves (admission is O(1): free slots vs. unused reserves of higher classes)
+    void setReservedCapacity(RequestClass requestClass, int slots);
+    int getReservedCapacity(RequestClass requestClass) const;
+    int getClassHeld(RequestClass requestClass) const;
+    bool admits(RequestClass requestClass, int heldBack = 0) const;  // heldBack: extra slots to leave free
+    int getAdmissibleSlots(RequestClass requestClass, int heldBack = 0) const;  // Free slots the class may still take
+    int getBookableSlots() const;      // In-service slots left once every class reserve is set aside
+    void chargeClass(RequestClass requestClass, int slots = 1);    // Under the shard lock
+    void refundClass(RequestClass requestClass, int slots = 1);
+    
+    // Negative Cache (recorded and invalidated under the shard lock, checked lock-free)
+    bool isKnownMiss(unsigned int required, int length = 1) const;
+    void recordMiss(unsigned int required, int length = 1);
+    void invalidateMisses();
+    long long getFreeEpoch() const;
+    
+    // Shard Locking (BasicLockable, so std::lock_guard<Zone> works).
+    // Hold it around any slot status change in this zone; never hold two zones at once.
+    void lock();
+    void unlock();
     
     // Display
     void displayZoneInfo() const;
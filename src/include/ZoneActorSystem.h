@@ -0,0 +1,106 @@
+#ifndef ZONE_ACTOR_SYSTEM_H
+#define ZONE_ACTOR_SYSTEM_H
+
+#include "Enums.h"
+#include "MpscRing.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// Forward declarations
+class ParkingSystem;
+class ParkingRequest;
+class Zone;
+
+// Mailbox entry; exactly one message per request is in flight at a time
+struct ZoneMessage {
+    ZoneMessageType type;
+    ParkingRequest* request;    // ZONE_MSG_ALLOCATE
+    int requestId;              // ZONE_MSG_EXIT / ZONE_MSG_CANCEL
+    int homeIndex;              // Requested zone (dense ZoneGraph index)
+    int fallbackIndex;          // Position in the home zone's fallback list, -1 = home zone
+
+    ZoneMessage() : type(ZONE_MSG_ALLOCATE), request(nullptr), requestId(-1),
+                    homeIndex(-1), fallbackIndex(-1) {}
+};
+
+// Actor execution mode: every zone is owned by one thread with its own mailbox.
+// Only the owning actor touches a zone's slots, bitmaps and summary, so no
+// shard lock is taken. A zone that cannot serve a request forwards it as a
+// message to the next zone on the requester's fallback list instead of
+// reaching into that zone's slots. Exits and cancels go to the actor owning
+// the request's slot, which releases it with the same bookkeeping as
+// ParkingSystem::markVehicleExited / cancelRequest (request state, class
+// refund, no-show timer, trip history).
+// While actors run, allocate, exit and cancel only through this class
+// (markVehicleArrived is safe; it does not touch slots). Paths that write
+// slots under the shard lock are excluded: waitlist handoff and
+// serveWaitlists, expireNoShows, and advanceReservations,
+// checkInReservation and cancelReservation (holds are SLOT_RESERVED
+// slots). Debug builds refuse them between start() and stop(); run them
+// while the actors are stopped.
+class ZoneActorSystem {
+private:
+    struct ZoneActor {
+        Zone* zone;
+        MpscRing<ZoneMessage>* mailbox;
+        std::thread thread;
+        std::mutex sleepLock;
+        std::condition_variable wakeup;
+
+        // Written by the actor thread only; read after waitIdle()/stop()
+        long long forwarded;
+        long long sameZone;
+        long long crossZone;
+        long long failed;
+        long long released;         // Exits and cancels applied
+
+        ZoneActor();
+    };
+
+    ParkingSystem* system;
+    ZoneActor* actors;          // Indexed like ZoneGraph zones
+    int actorCount;
+    int mailboxCapacity;
+    std::atomic<bool> running;
+    std::atomic<int> inFlight;  // Accepted messages not finished yet (bounds every mailbox)
+
+    std::mutex idleLock;
+    std::condition_variable idle;
+
+    void deliver(int actor, const ZoneMessage& message);
+    void finish();
+    void handle(int actor, const ZoneMessage& message);
+    void handleAllocate(int actor, ZoneMessage message);
+    bool post(ZoneMessageType type, int requestId);     // Exit / cancel, routed by slot
+    void actorLoop(int actor);
+
+public:
+    // Constructor & Destructor (zones must be registered before construction)
+    ZoneActorSystem(ParkingSystem* parkingSystem, int mailboxCapacity = 4096);
+    ~ZoneActorSystem();
+
+    ZoneActorSystem(const ZoneActorSystem& other) = delete;
+    ZoneActorSystem& operator=(const ZoneActorSystem& other) = delete;
+
+    // Lifecycle
+    bool start();
+    void stop();                // Finishes in-flight messages, then joins
+    void waitIdle();
+
+    // Messages (false if the request is unknown, holds no slot, or too many are in flight)
+    bool allocate(int requestId);
+    bool exit(int requestId);   // OCCUPIED
+    bool cancel(int requestId); // ALLOCATED; a REQUESTED request may still be in flight
+
+    // Statistics (totals over all actors; call after waitIdle)
+    int getActorCount() const;
+    long long getForwardedCount() const;
+    long long getSameZoneCount() const;
+    long long getCrossZoneCount() const;
+    long long getReleasedCount() const;
+    long long getFailedCount() const;
+};
+
+#endif // ZONE_ACTOR_SYSTEM_H
@@ -0,0 +1,84 @@
+#ifndef ZONE_GRAPH_H
+#define ZONE_GRAPH_H
+
+#include "DynamicArray.h"
+#include <atomic>
+#include <mutex>
+
+// Forward declaration
+class Zone;
+
+// One entry in a zone's fallback list
+struct ZoneFallback {
+    int zoneIndex;      // Dense zone index (see ZoneGraph::getZone)
+    int cost;           // Sum of edge weights along the cheapest path
+    int hops;           // Edges on that path
+
+    ZoneFallback() : zoneIndex(-1), cost(0), hops(0) {}
+};
+
+// Compiled zone adjacency graph.
+// Zones get dense indices as they are registered, and zone IDs resolve to them
+// through an open-addressing table. The per-zone adjacency lists are flattened
+// into CSR arrays (rowStart / edgeTarget / edgeWeight). Each zone also gets a
+// precomputed fallback list: every reachable zone, ordered by Dijkstra path
+// cost. Compilation is lazy; topology changes only mark the graph dirty.
+// Concurrent readers are safe (the first one to see the dirty flag compiles
+// under compileLock); topology changes must not race with readers.
+class ZoneGraph {
+private:
+    DynamicArray<Zone*> zones;      // index -> zone
+
+    // Zone ID -> index (linear probing, capacity is a power of two)
+    int* idKeys;
+    int* idIndices;
+    int idCapacity;
+
+    // Compiled form
+    std::atomic<bool> dirty;
+    std::mutex compileLock;
+    int compileCount;
+    int compiledZoneCount;
+    int* rowStart;                  // Edges of zone i are [rowStart[i], rowStart[i + 1])
+    int* edgeTarget;
+    int* edgeWeight;
+    int edgeCount;
+    int* fallbackStart;             // Fallbacks of zone i are [fallbackStart[i], fallbackStart[i + 1])
+    ZoneFallback* fallbacks;
+
+    static const int EMPTY_KEY = -1;
+
+    int probeIndex(int zoneId) const;
+    void growIdTable();
+    void releaseCompiled();
+    void compile();
+    void ensureCompiled();
+    int shortestPaths(int source, int* dist, int* hops, int* order,
+                      int* heap, int* heapPos) const;
+
+public:
+    // Constructor & Destructor
+    ZoneGraph();
+    ~ZoneGraph();
+
+    ZoneGraph(const ZoneGraph& other) = delete;
+    ZoneGraph& operator=(const ZoneGraph& other) = delete;
+
+    // Registration
+    int addZone(Zone* zone);
+    void invalidate();
+
+    // Lookup
+    int findZoneIndex(int zoneId) const;
+    Zone* findZone(int zoneId) const;
+    Zone* getZone(int index) const;
+    int getZoneCount() const;
+
+    // Compiled queries (recompile first if the topology changed)
+    int getEdgeCount();
+    int getFallbackCount(int zoneIndex);
+    const ZoneFallback* getFallbacks(int zoneIndex);
+    int getCompileCount() const;
+};
+
+#endif // ZONE_GRAPH_H
@@ -1,7 +1,15 @@
 #include <iostream>
 #include <thread>
+#include <atomic>
 #include <chrono>
+#include <sstream>
+#include <cstring>
 #include "include/ParkingSystem.h"
+#include "include/GateIngest.h"
+#include "include/ZoneActorSystem.h"
+#include "include/TimingWheel.h"
+#include "include/IndexedMinHeap.h"
+#include "include/AllocationPolicies.h"
 
 using namespace std;
 
@@ -228,6 +236,2148 @@ void testEdgeCases(ParkingSystem& system) {
     system.displayAllRequests();
 }
 
+void testSlotSearchModes() {
+    cout << "TEST 11: Bitmap vs Linear Slot Search" << endl;
+    printSeparator();
+    
+    // Large area at 95% occupancy, filled first-fit from slot 0
+    const int slotCount = 4096;
+    const int occupiedCount = slotCount * 95 / 100;
+    ParkingArea area(901, 9, "Benchmark Area", slotCount);
+    for (int i = 0; i < slotCount; i++) {
+        if (i < occupiedCount) {
+            char vehicleId[20];
+            sprintf(vehicleId, "BENCH%04d", i);
+            area.getSlotByIndex(i)->allocate(vehicleId);
+        }
+    }
+    
+    const int lookups = 2000;
+    bool consistent = true;
+    
+    area.setSearchMode(SEARCH_LINEAR);
+    ParkingSlot* linearSlot = nullptr;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        linearSlot = area.findFirstAvailableSlot();
+    }
+    auto linearTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    area.setSearchMode(SEARCH_BITMAP);
+    ParkingSlot* bitmapSlot = nullptr;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        bitmapSlot = area.findFirstAvailableSlot();
+    }
+    auto bitmapTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    if (linearSlot != bitmapSlot) consistent = false;
+    
+    // Allocate / release / maintenance changes must keep both modes in agreement
+    bitmapSlot->allocate("BENCH_NEXT");
+    area.getSlotByIndex(39)->setStatus(SLOT_MAINTENANCE);
+    area.getSlotByIndex(5)->release();
+    if (area.findFirstAvailableSlotLinear() != area.findFirstAvailableSlotBitmap()) consistent = false;
+    if (area.findFirstAvailableSlotSimd() != area.findFirstAvailableSlotBitmap()) consistent = false;
+    
+    cout << "Slots: " << slotCount << ", free: " << (slotCount - occupiedCount) << ", lookups: " << lookups << endl;
+    cout << "Linear search: " << linearTime << " us" << endl;
+    cout << "Bitmap search: " << bitmapTime << " us" << endl;
+    cout << "First free slot after updates: " << area.findFirstAvailableSlot()->getSlotId() << endl;
+    
+    // Multi-storey zone: 40 levels, all but the last one full
+    Zone tower(9, "Tower");
+    for (int level = 0; level < 40; level++) {
+        tower.addParkingArea(new ParkingArea(950 + level, 9, "Level", 64));
+    }
+    for (int level = 0; level < 39; level++) {
+        ParkingArea* levelArea = tower.getAreaByIndex(level);
+        while (levelArea->findFirstAvailableSlot() != nullptr) {
+            levelArea->findFirstAvailableSlot()->allocate("TOWER");
+        }
+    }
+    
+    tower.setSlotSearchMode(SEARCH_LINEAR);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        linearSlot = tower.findAvailableSlot();
+    }
+    linearTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    tower.setSlotSearchMode(SEARCH_BITMAP);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        bitmapSlot = tower.findAvailableSlot();
+    }
+    bitmapTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    if (linearSlot != bitmapSlot) consistent = false;
+    
+    cout << "\nZone with " << tower.getAreaCount() << " areas, " 
+         << tower.getAreasWithCapacityCount() << " with capacity" << endl;
+    cout << "Linear area probing: " << linearTime << " us" << endl;
+    cout << "Summary bitmap:      " << bitmapTime << " us" << endl;
+    cout << "Search modes consistent: " << (consistent ? "YES" : "NO") << endl;
+}
+
+void testSlotDirectory() {
+    cout << "TEST 12: Slot Directory" << endl;
+    printSeparator();
+    
+    // Area 7 has more than 1000 slots, so it uses a wider ID stride;
+    // area 70 would mint the same IDs and gets re-keyed by the directory
+    ParkingSystem system;
+    Zone* zoneA = new Zone(1, "Stadium");
+    zoneA->addParkingArea(new ParkingArea(7, 1, "North Stand", 1500));
+    system.addZone(zoneA);
+    Zone* zoneB = new Zone(2, "Depot");
+    system.addZone(zoneB);
+    zoneB->addParkingArea(new ParkingArea(70, 2, "Yard", 3));
+    
+    SlotDirectory* directory = system.getSlotDirectory();
+    cout << "Registered slots: " << directory->getSlotCount() << endl;
+    
+    ParkingSlot* last = system.findSlotById(7 * 10000 + 1499);
+    cout << "Slot 71499 -> area " << (last ? last->getAreaId() : -1) << endl;
+    
+    ParkingSlot* yardSlot = zoneB->getAreaByIndex(0)->getSlotByIndex(0);
+    int handle = yardSlot->getSlotHandle();
+    cout << "Yard slot ID " << yardSlot->getSlotId() << " -> handle " << handle
+         << ", zone " << directory->getZone(handle)->getZoneName()
+         << ", area " << directory->getArea(handle)->getAreaName() << endl;
+    
+    bool resolved = (system.findSlotById(yardSlot->getSlotId()) == yardSlot) &&
+                    (system.findSlotById(70000) == zoneA->getAreaByIndex(0)->getSlotByIndex(0)) &&
+                    (system.findSlotByHandle(handle) == yardSlot);
+    cout << "All IDs resolve uniquely: " << (resolved ? "YES" : "NO") << endl;
+}
+
+void testVehicleIndex() {
+    cout << "TEST 13: Active Request Index by Vehicle" << endl;
+    printSeparator();
+    
+    ParkingSystem system;
+    Zone* zone = new Zone(1, "IndexZone");
+    zone->addParkingArea(new ParkingArea(101, 1, "IndexArea", 5));
+    system.addZone(zone);
+    
+    // Same plate parks twice: the index must return the live request, not the first one
+    int first = system.createRequest("REPEAT01", 1);
+    system.processRequest(first);
+    system.markVehicleArrived(first);
+    system.markVehicleExited(first);
+    int second = system.createRequest("REPEAT01", 1);
+    
+    ParkingRequest* live = system.findRequestByVehicle("REPEAT01");
+    cout << "Live request for REPEAT01: " << (live ? live->getRequestId() : -1)
+         << " (expected " << second << ")" << endl;
+    
+    system.cancelRequest(second);
+    cout << "After cancel: " << (system.findRequestByVehicle("REPEAT01") == nullptr ? "no live request" : "still indexed") << endl;
+    
+    // Two live requests for one plate: dropping the newer must not unindex the older
+    int older = system.createRequest("DUP01", 1);
+    system.processRequest(older);
+    int newer = system.createRequest("DUP01", 1);
+    system.cancelRequest(newer);
+    ParkingRequest* survivor = system.findRequestByVehicle("DUP01");
+    cout << "Older DUP01 request after the newer is cancelled: " << (survivor ? survivor->getRequestId() : -1)
+         << " (expected " << older << ")" << endl;
+    system.cancelRequest(older);
+    
+    // Churn many plates through the index and check every survivor resolves
+    bool consistent = true;
+    DynamicArray<int> ids;
+    for (int i = 0; i < 200; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "IDX%03d", i);
+        ids.add(system.createRequest(vehicleId, 1));
+    }
+    for (int i = 0; i < 200; i += 2) {
+        system.cancelRequest(ids[i]);
+    }
+    for (int i = 0; i < 200; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "IDX%03d", i);
+        ParkingRequest* found = system.findRequestByVehicle(vehicleId);
+        bool expectLive = (i % 2 == 1);
+        if (expectLive != (found != nullptr) || (found && found->getRequestId() != ids[i])) {
+            consistent = false;
+        }
+    }
+    cout << "Active vehicles: " << system.getActiveVehicleCount() << endl;
+    cout << "Index consistent after churn: " << (consistent ? "YES" : "NO") << endl;
+}
+
+void testRequestRecycling() {
+    cout << "TEST 14: Request Table Recycling" << endl;
+    printSeparator();
+    
+    ParkingSystem system;
+    Zone* zone = new Zone(1, "RecycleZone");
+    zone->addParkingArea(new ParkingArea(101, 1, "RecycleArea", 2));
+    system.addZone(zone);
+    
+    // Run full lifecycles back to back; at most one request is live at a time
+    int lastId = -1;
+    for (int i = 0; i < 30; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "RECYCLE%02d", i);
+        lastId = system.createRequest(vehicleId, 1);
+        system.processRequest(lastId);
+        if (i % 3 == 0) {
+            system.cancelRequest(lastId);
+        } else {
+            system.markVehicleArrived(lastId);
+            system.markVehicleExited(lastId);
+        }
+    }
+    
+    RequestTable* table = system.getRequestTable();
+    cout << "\nTotal requests:   " << table->getTotalCount() << endl;
+    cout << "Live requests:    " << table->getLiveCount() << endl;
+    cout << "Archived records: " << table->getArchivedCount() << endl;
+    cout << "Pooled objects:   " << table->getRecycledCount() << endl;
+    
+    const ArchivedRequest* archived = system.getArchivedRequest(lastId);
+    cout << "Last request archived as: " 
+         << (archived ? StateValidator::getStateString(archived->finalState) : "MISSING") << endl;
+    
+    cout << "\nOperating on a retired request:" << endl;
+    system.processRequest(lastId);
+}
+
+void testSlotTableStartup() {
+    cout << "TEST 15: SoA Slot Table Startup" << endl;
+    printSeparator();
+    
+    // City with one million slots: 250 areas x 4000 slots over 10 zones
+    auto start = chrono::steady_clock::now();
+    ParkingSystem city;
+    for (int z = 0; z < 10; z++) {
+        Zone* zone = new Zone(z + 1, "CityZone");
+        for (int a = 0; a < 25; a++) {
+            int areaId = (z + 1) * 100 + a;
+            zone->addParkingArea(new ParkingArea(areaId, z + 1, "CityArea", 4000));
+        }
+        city.addZone(zone);
+    }
+    auto buildTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    
+    // Maintenance sweep over one zone, then a full-city recount from the status columns
+    Zone* firstZone = city.getZoneById(1);
+    for (int a = 0; a < firstZone->getAreaCount(); a++) {
+        ParkingArea* area = firstZone->getAreaByIndex(a);
+        for (int i = 0; i < area->getTotalSlots(); i += 10) {
+            area->getSlotByIndex(i)->setStatus(SLOT_MAINTENANCE);
+        }
+    }
+    
+    start = chrono::steady_clock::now();
+    int maintenance = 0;
+    int available = 0;
+    for (int z = 0; z < city.getZoneCount(); z++) {
+        Zone* zone = city.getZoneById(z + 1);
+        for (int a = 0; a < zone->getAreaCount(); a++) {
+            SlotTable* table = zone->getAreaByIndex(a)->getSlotTable();
+            maintenance += table->countStatus(SLOT_MAINTENANCE);
+            available += table->countStatus(SLOT_AVAILABLE);
+        }
+    }
+    auto scanTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    SlotTable* sample = firstZone->getAreaByIndex(0)->getSlotTable();
+    cout << "Slots registered:      " << city.getSlotDirectory()->getSlotCount() << endl;
+    cout << "Build time:            " << buildTime << " ms" << endl;
+    cout << "Arena bytes per slot:  " << (sample->getArenaBytes() / sample->getSlotCount()) << endl;
+    cout << "Full-city recount:     " << scanTime << " us" << endl;
+    cout << "Maintenance / Free:    " << maintenance << " / " << available << endl;
+}
+
+void testSlotKernels() {
+    cout << "TEST 16: SIMD Slot Status Kernels" << endl;
+    printSeparator();
+    
+    cout << "Best kernel level on this CPU: " 
+         << SlotKernels::getLevelName(SlotKernels::getBestLevel()) << endl;
+    
+    // Odd length so every kernel exercises its scalar tail
+    const int count = 1000003;
+    unsigned char* statuses = new unsigned char[count];
+    unsigned int seed = 12345;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int r = (seed >> 16) % 100;
+        statuses[i] = (r < 90) ? SLOT_OCCUPIED : (r < 95) ? SLOT_MAINTENANCE 
+                    : (r < 97) ? SLOT_RESERVED : SLOT_AVAILABLE;
+    }
+    // Leading maintenance run and a late first free slot
+    for (int i = 0; i < 777; i++) statuses[i] = SLOT_MAINTENANCE;
+    for (int i = 0; i < 900001; i++) {
+        if (statuses[i] == SLOT_AVAILABLE) statuses[i] = SLOT_OCCUPIED;
+    }
+    
+    KernelLevel levels[] = { KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2 };
+    SlotStatusCounts reference = SlotKernels::countStatuses(statuses, count, KERNEL_SCALAR);
+    int referenceFree = SlotKernels::findFirstAvailable(statuses, count, KERNEL_SCALAR);
+    int referenceInService = SlotKernels::findFirstNotMaintenance(statuses, count, KERNEL_SCALAR);
+    bool consistent = true;
+    
+    for (int l = 0; l < 3; l++) {
+        if (!SlotKernels::isSupported(levels[l])) {
+            cout << SlotKernels::getLevelName(levels[l]) << ": not supported" << endl;
+            continue;
+        }
+        
+        auto start = chrono::steady_clock::now();
+        SlotStatusCounts counts;
+        for (int rep = 0; rep < 10; rep++) {
+            counts = SlotKernels::countStatuses(statuses, count, levels[l]);
+        }
+        auto countTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 10;
+        
+        int firstFree = SlotKernels::findFirstAvailable(statuses, count, levels[l]);
+        int firstInService = SlotKernels::findFirstNotMaintenance(statuses, count, levels[l]);
+        
+        if (counts.available != reference.available || counts.occupied != reference.occupied ||
+            counts.reserved != reference.reserved || counts.maintenance != reference.maintenance ||
+            firstFree != referenceFree || firstInService != referenceInService) {
+            consistent = false;
+        }
+        
+        cout << SlotKernels::getLevelName(levels[l]) << ": count " << countTime << " us"
+             << ", first free " << firstFree << ", first in service " << firstInService << endl;
+    }
+    
+    cout << "Counts (A/O/R/M): " << reference.available << "/" << reference.occupied << "/"
+         << reference.reserved << "/" << reference.maintenance << endl;
+    cout << "Kernels consistent: " << (consistent ? "YES" : "NO") << endl;
+    
+    delete[] statuses;
+}
+
+void testVehicleIdPool() {
+    cout << "TEST 17: Interned Vehicle ID Pool" << endl;
+    printSeparator();
+    
+    ParkingSystem system;
+    Zone* zone = new Zone(1, "CommuterZone");
+    zone->addParkingArea(new ParkingArea(101, 1, "CommuterArea", 50));
+    system.addZone(zone);
+    
+    // 200 commuters making 20,000 trips: every plate is copied exactly once
+    const int commuters = 200;
+    const int trips = 20000;
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < trips; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "COMMUTER%03d", i % commuters);
+        int req = system.createRequest(vehicleId, 1);
+        system.processRequest(req);
+        system.markVehicleArrived(req);
+        system.markVehicleExited(req);
+    }
+    auto tripTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    
+    VehicleIdPool* pool = system.getVehiclePool();
+    cout << "Trips completed:     " << system.getCompletedTrips() << endl;
+    cout << "Interned plates:     " << pool->getSize() << endl;
+    cout << "Pool bytes:          " << pool->getBytesUsed() << endl;
+    cout << "Avg trip cycle:      " << (tripTime * 1000 / trips) << " ns" << endl;
+    
+    // Handles are stable and shared between request, slot and archive
+    int req = system.createRequest("COMMUTER007", 1);
+    system.processRequest(req);
+    ParkingRequest* request = system.getRequestById(req);
+    ParkingSlot* slot = system.findSlotByHandle(request->getAllocatedSlotHandle());
+    VehicleHandle handle = pool->find("COMMUTER007");
+    bool shared = request->getVehicleHandle() == handle &&
+                  slot->getAllocatedVehicleHandle() == handle &&
+                  strcmp(slot->getAllocatedVehicleId(), "COMMUTER007") == 0 &&
+                  system.getArchivedRequest(7)->vehicle == pool->find("COMMUTER006");
+    cout << "Unknown plate handle: " << pool->find("NOT-A-PLATE") << endl;
+    cout << "Handles shared across records: " << (shared ? "YES" : "NO") << endl;
+}
+
+void testOccupancyCounters() {
+    cout << "TEST 18: Hierarchical Occupancy Counters" << endl;
+    printSeparator();
+    
+    ParkingSystem system;
+    for (int z = 1; z <= 3; z++) {
+        Zone* zone = new Zone(z, "CounterZone");
+        zone->addParkingArea(new ParkingArea(z * 10 + 1, z, "CounterA", 40));
+        zone->addParkingArea(new ParkingArea(z * 10 + 2, z, "CounterB", 25));
+        system.addZone(zone);
+    }
+    system.getZoneById(1)->addAdjacentZone(2);
+    system.getZoneById(2)->addAdjacentZone(3);
+    
+    // Mixed churn through the engine, direct slot writes and maintenance
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    DynamicArray<int> live;
+    unsigned int seed = 2024;
+    for (int i = 0; i < 3000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int op = (seed >> 16) % 10;
+        if (op < 5 || live.isEmpty()) {
+            char vehicleId[20];
+            sprintf(vehicleId, "CNT%04d", i);
+            int req = system.createRequest(vehicleId, (int)((seed >> 8) % 3) + 1);
+            if (system.processRequest(req)) {
+                system.markVehicleArrived(req);
+                live.add(req);
+            } else {
+                system.cancelRequest(req);
+            }
+        } else if (op < 9) {
+            int pick = (int)((seed >> 4) % live.getSize());
+            system.markVehicleExited(live[pick]);
+            live.remove(pick);
+        } else {
+            ParkingArea* area = system.getZoneById((int)(seed % 3) + 1)->getAreaByIndex((seed >> 3) % 2);
+            ParkingSlot* slot = area->getSlotByIndex((seed >> 5) % area->getTotalSlots());
+            if (slot->getStatus() == SLOT_AVAILABLE) {
+                slot->setStatus(SLOT_MAINTENANCE);
+            } else if (slot->getStatus() == SLOT_MAINTENANCE) {
+                slot->setStatus(SLOT_AVAILABLE);
+            }
+        }
+    }
+    cout.rdbuf(original);
+    
+    // Every level must agree with a full recount of the status columns
+    bool consistent = true;
+    for (int z = 1; z <= 3; z++) {
+        Zone* zone = system.getZoneById(z);
+        SlotStatusCounts audit = zone->getStatusCounts();
+        if (zone->getOccupiedSlots() != audit.total() - audit.available ||
+            zone->getOccupancy()->getCount(SLOT_MAINTENANCE) != audit.maintenance) {
+            consistent = false;
+        }
+        for (int a = 0; a < zone->getAreaCount(); a++) {
+            ParkingArea* area = zone->getAreaByIndex(a);
+            if (area->getAvailableSlots() != area->getStatusCounts().available) {
+                consistent = false;
+            }
+        }
+    }
+    SlotStatusCounts cityAudit = system.auditSlotStatuses();
+    const OccupancyCounter* city = system.getCityOccupancy();
+    if (city->getTotalSlots() != cityAudit.total() || city->getAvailableSlots() != cityAudit.available ||
+        city->getCount(SLOT_OCCUPIED) != cityAudit.occupied) {
+        consistent = false;
+    }
+    
+    // Dashboard-style polling is a read of the city counter
+    auto start = chrono::steady_clock::now();
+    float utilization = 0.0f;
+    for (int i = 0; i < 1000000; i++) {
+        utilization = system.getSystemUtilization();
+    }
+    auto pollTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    cout << "Vehicles parked:      " << live.getSize() << endl;
+    cout << "City occupied/total:  " << city->getCount(SLOT_OCCUPIED) << "/" << city->getTotalSlots() << endl;
+    cout << "In maintenance:       " << city->getCount(SLOT_MAINTENANCE) << endl;
+    cout << "System utilization:   " << (utilization * 100) << "%" << endl;
+    cout << "1M utilization polls: " << pollTime << " us" << endl;
+    cout << "Counters match recount: " << (consistent ? "YES" : "NO") << endl;
+}
+
+void buildSurgeCity(ParkingSystem& system) {
+    // Three zones of 200 slots in a line: 1 - 2 - 3
+    for (int z = 1; z <= 3; z++) {
+        Zone* zone = new Zone(z, "SurgeZone");
+        for (int a = 0; a < 4; a++) {
+            zone->addParkingArea(new ParkingArea(z * 10 + a, z, "SurgeArea", 50));
+        }
+        system.addZone(zone);
+    }
+    system.getZoneById(1)->addAdjacentZone(2);
+    system.getZoneById(2)->addAdjacentZone(1);
+    system.getZoneById(2)->addAdjacentZone(3);
+    system.getZoneById(3)->addAdjacentZone(2);
+}
+
+void testBatchAllocation() {
+    cout << "TEST 19: Batch Allocation from a Request Queue" << endl;
+    printSeparator();
+    
+    // Gate-open surge: 700 requests, zone 1 oversubscribed
+    const int surge = 700;
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    
+    ParkingSystem single;
+    buildSurgeCity(single);
+    cout.rdbuf(sink.rdbuf());
+    auto start = chrono::steady_clock::now();
+    int singleAllocated = 0;
+    for (int i = 0; i < surge; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "SURGE%04d", i);
+        int req = single.createRequest(vehicleId, (i % 10 < 6) ? 1 : (i % 10 < 8) ? 2 : 3);
+        if (single.processRequest(req)) singleAllocated++;
+    }
+    auto singleTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    
+    ParkingSystem batched;
+    buildSurgeCity(batched);
+    int cancelledId = -1;
+    for (int i = 0; i < surge; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "SURGE%04d", i);
+        int req = batched.submitRequest(vehicleId, (i % 10 < 6) ? 1 : (i % 10 < 8) ? 2 : 3);
+        if (i == 5) cancelledId = req;
+    }
+    cout.rdbuf(sink.rdbuf());
+    batched.cancelRequest(cancelledId);
+    cout.rdbuf(original);
+    
+    cout << "Queued before batch: " << batched.getPendingCount() << endl;
+    start = chrono::steady_clock::now();
+    BatchAllocationResult result = batched.processPendingRequests();
+    auto batchTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    const OccupancyCounter* city = batched.getCityOccupancy();
+    cout << "Processed / skipped:   " << result.processed << " / " << result.skipped << endl;
+    cout << "Same-zone / cross-zone: " << result.sameZone << " / " << result.crossZone << endl;
+    cout << "Re-queued:             " << result.requeued << " (pending " << batched.getPendingCount() << ")" << endl;
+    cout << "Occupied slots:        " << city->getCount(SLOT_OCCUPIED) << endl;
+    // One-by-one lets early zone-1 arrivals take zone 2's slots and push zone 2
+    // into zone 3; the batch serves each zone's own demand before spilling
+    cout << "One-by-one allocated:  " << singleAllocated << endl;
+    cout << "One-by-one time:       " << singleTime << " us" << endl;
+    cout << "Batch time:            " << batchTime << " us" << endl;
+    
+    // Free a few slots and drain the re-queued requests
+    cout.rdbuf(sink.rdbuf());
+    int freed = 0;
+    for (int id = 1; id <= surge && freed < 25; id++) {
+        ParkingRequest* request = batched.getRequestById(id);
+        if (request != nullptr && request->getState() == ALLOCATED) {
+            batched.markVehicleArrived(id);
+            batched.markVehicleExited(id);
+            freed++;
+        }
+    }
+    cout.rdbuf(original);
+    BatchAllocationResult retry = batched.processPendingRequests();
+    
+    // Every allocated request must own a distinct occupied slot
+    int holders = 0;
+    bool consistent = true;
+    for (int id = 1; id <= surge; id++) {
+        ParkingRequest* request = batched.getRequestById(id);
+        if (request == nullptr || request->getState() != ALLOCATED) continue;
+        ParkingSlot* slot = batched.findSlotByHandle(request->getAllocatedSlotHandle());
+        if (slot == nullptr || slot->getAllocatedVehicleHandle() != request->getVehicleHandle()) {
+            consistent = false;
+        }
+        holders++;
+    }
+    if (holders != city->getCount(SLOT_OCCUPIED) ||
+        holders != result.allocated() - freed + retry.allocated()) {
+        consistent = false;
+    }
+    
+    cout << "Second batch allocated: " << retry.allocated() << endl;
+    cout << "Batch consistent: " << (consistent ? "YES" : "NO") << endl;
+}
+
+void testMultiHopFallback() {
+    cout << "TEST 20: Multi-Hop Zone Fallback" << endl;
+    printSeparator();
+    
+    // District: 1 -(1)- 2 -(1)- 3 -(4)- 4, plus a direct but costly 1 -(9)- 4
+    ParkingSystem system;
+    for (int z = 1; z <= 4; z++) {
+        Zone* zone = new Zone(z, "DistrictZone");
+        zone->addParkingArea(new ParkingArea(z * 10, z, "DistrictArea", 2));
+        system.addZone(zone);
+    }
+    int links[][3] = { {1, 2, 1}, {2, 3, 1}, {3, 4, 4}, {1, 4, 9} };
+    for (int i = 0; i < 4; i++) {
+        system.getZoneById(links[i][0])->addAdjacentZone(links[i][1], links[i][2]);
+        system.getZoneById(links[i][1])->addAdjacentZone(links[i][0], links[i][2]);
+    }
+    
+    ZoneGraph* graph = system.getZoneGraph();
+    int source = graph->findZoneIndex(1);
+    const ZoneFallback* fallbacks = graph->getFallbacks(source);
+    cout << "Edges: " << graph->getEdgeCount() << ", fallback order from zone 1:";
+    for (int i = 0; i < graph->getFallbackCount(source); i++) {
+        cout << " " << graph->getZone(fallbacks[i].zoneIndex)->getZoneId()
+             << "(cost " << fallbacks[i].cost << ", hops " << fallbacks[i].hops << ")";
+    }
+    cout << endl;
+    
+    // Fill zones 1 and 2; the next zone-1 request lands two hops away in zone 3
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 4; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "DIST%02d", i);
+        system.processRequest(system.createRequest(vehicleId, i < 2 ? 1 : 2));
+    }
+    cout.rdbuf(original);
+    
+    system.processRequest(system.createRequest("TWOHOP", 1));
+    ParkingRequest* twoHop = system.findRequestByVehicle("TWOHOP");
+    cout << "Two-hop request placed in zone: " 
+         << system.findSlotByHandle(twoHop->getAllocatedSlotHandle())->getZoneId() << endl;
+    
+    // Hop limit 1 leaves only zone 2 (full); zone 4's cheapest path is 3 hops
+    system.getAllocationEngine()->setFallbackLimits(1, -1);
+    system.processRequest(system.createRequest("ONEHOP", 1));
+    
+    // Cost limit 3 stops before zone 4 (cost 6 via 3, 9 direct)
+    system.getAllocationEngine()->setFallbackLimits(-1, 3);
+    system.processRequest(system.createRequest("CHEAP", 1));
+    system.getAllocationEngine()->setFallbackLimits(-1, -1);
+    
+    // Zone lookups go through the graph's ID table; compiles stay lazy
+    int compilesBefore = graph->getCompileCount();
+    system.getZoneById(3)->addAdjacentZone(1, 2);
+    system.getZoneById(1)->addAdjacentZone(3, 2);
+    graph->getFallbacks(source);
+    cout << "Recompiles after adding a shortcut: " << (graph->getCompileCount() - compilesBefore) << endl;
+    cout << "Zone 3 now at cost " << graph->getFallbacks(source)[1].cost 
+         << ", hops " << graph->getFallbacks(source)[1].hops << endl;
+}
+
+void buildCrossTown(ParkingSystem& system) {
+    // Zones 1 and 2 both feed zone 3 (cost 1); only zone 1 also reaches zone 4 (cost 2)
+    for (int z = 1; z <= 4; z++) {
+        Zone* zone = new Zone(z, "CrossTownZone");
+        zone->addParkingArea(new ParkingArea(z * 10, z, "CrossTownArea", 10));
+        system.addZone(zone);
+    }
+    int links[][3] = { {1, 3, 1}, {2, 3, 1}, {1, 4, 2} };
+    for (int i = 0; i < 3; i++) {
+        system.getZoneById(links[i][0])->addAdjacentZone(links[i][1], links[i][2]);
+        system.getZoneById(links[i][1])->addAdjacentZone(links[i][0], links[i][2]);
+    }
+}
+
+void testMinCostBatch() {
+    cout << "TEST 21: Min-Cost Batch Assignment" << endl;
+    printSeparator();
+    
+    // 20 requests each for zones 1 and 2 (10 slots apiece), fallbacks capped at cost 2.
+    // Greedy lets zone 1 spill into zone 3, leaving zone 2 nowhere to go.
+    BatchAssignmentMode modes[2] = { BATCH_GREEDY, BATCH_MIN_COST };
+    const char* names[2] = { "Greedy", "Min-cost" };
+    for (int m = 0; m < 2; m++) {
+        ParkingSystem system;
+        buildCrossTown(system);
+        system.getAllocationEngine()->setFallbackLimits(-1, 2);
+        system.getAllocationEngine()->setBatchAssignmentMode(modes[m]);
+        for (int i = 0; i < 40; i++) {
+            char vehicleId[20];
+            sprintf(vehicleId, "XTOWN%02d", i);
+            system.submitRequest(vehicleId, (i % 2 == 0) ? 1 : 2);
+        }
+        BatchAllocationResult result = system.processPendingRequests();
+        cout << names[m] << ": allocated " << result.allocated() 
+             << ", cross-zone " << result.crossZone 
+             << ", penalty " << result.penaltyCost 
+             << ", zone 4 occupied " << system.getZoneById(4)->getOccupancy()->getCount(SLOT_OCCUPIED) << endl;
+    }
+    
+    // Uncapped, both modes place all 40 with 20 cross-zone. Greedy gives zone 3
+    // to zone 1's overflow, so zone 2's goes to zone 4 at cost 4; min-cost sends
+    // zone 1's to zone 4 (cost 2) and zone 2's to zone 3 (cost 1)
+    for (int m = 0; m < 2; m++) {
+        ParkingSystem system;
+        buildCrossTown(system);
+        system.getAllocationEngine()->setBatchAssignmentMode(modes[m]);
+        for (int i = 0; i < 40; i++) {
+            char vehicleId[20];
+            sprintf(vehicleId, "XTOWN%02d", i);
+            system.submitRequest(vehicleId, (i % 2 == 0) ? 1 : 2);
+        }
+        BatchAllocationResult result = system.processPendingRequests();
+        cout << names[m] << " uncapped: allocated " << result.allocated() 
+             << ", cross-zone " << result.crossZone 
+             << ", penalty " << result.penaltyCost << endl;
+    }
+    
+    // Zone 3 keeps 5 of its 10 slots for permits: the plan must count only the
+    // slots standard requests may take, and send the rest of zone 1's overflow elsewhere
+    {
+        ParkingSystem system;
+        buildCrossTown(system);
+        system.getZoneById(3)->setReservedCapacity(CLASS_PERMIT, 5);
+        system.getAllocationEngine()->setBatchAssignmentMode(BATCH_MIN_COST);
+        for (int i = 0; i < 20; i++) {
+            char vehicleId[20];
+            sprintf(vehicleId, "XTOWN%02d", i);
+            system.submitRequest(vehicleId, 1);
+        }
+        BatchAllocationResult result = system.processPendingRequests();
+        cout << "Min-cost with a permit reserve in zone 3: allocated " << result.allocated() 
+             << " (cross-zone " << result.crossZone << "), re-queued " << result.requeued 
+             << ", zone 3 occupied " << system.getZoneById(3)->getOccupancy()->getCount(SLOT_OCCUPIED) << endl;
+    }
+    
+    // Same surge as test 19 under both modes
+    const int surge = 700;
+    for (int m = 0; m < 2; m++) {
+        ParkingSystem system;
+        buildSurgeCity(system);
+        system.getAllocationEngine()->setBatchAssignmentMode(modes[m]);
+        for (int i = 0; i < surge; i++) {
+            char vehicleId[20];
+            sprintf(vehicleId, "SURGE%04d", i);
+            system.submitRequest(vehicleId, (i % 10 < 6) ? 1 : (i % 10 < 8) ? 2 : 3);
+        }
+        auto start = chrono::steady_clock::now();
+        BatchAllocationResult result = system.processPendingRequests();
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        cout << names[m] << " surge: allocated " << result.allocated() 
+             << ", cross-zone " << result.crossZone 
+             << ", penalty " << result.penaltyCost << endl;
+        cout << names[m] << " surge time: " << elapsed << " us" << endl;
+    }
+}
+
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+void buildStressCity(ParkingSystem& system, int zoneCount) {
+    // Ring of zones, two 100-slot areas each
+    for (int z = 1; z <= zoneCount; z++) {
+        Zone* zone = new Zone(z, "StressZone");
+        zone->addParkingArea(new ParkingArea(z * 10, z, "StressArea", 100));
+        zone->addParkingArea(new ParkingArea(z * 10 + 1, z, "StressArea", 100));
+        system.addZone(zone);
+    }
+    for (int z = 1; z <= zoneCount; z++) {
+        int next = (z % zoneCount) + 1;
+        system.getZoneById(z)->addAdjacentZone(next);
+        system.getZoneById(next)->addAdjacentZone(z);
+    }
+}
+
+void stressGateway(ParkingSystem* system, int gateway, int operations, int zoneCount) {
+    unsigned int seed = 12345u + gateway * 7919u;
+    for (int i = 0; i < operations; i++) {
+        seed = seed * 1103515245u + 12345u;
+        char vehicleId[24];
+        sprintf(vehicleId, "G%02dV%06d", gateway, i);
+        int req = system->createRequest(vehicleId, 1 + (int)((seed >> 16) % zoneCount));
+        if (system->processRequest(req)) {
+            // Churn: some cars park and leave, some cancel, the rest stay
+            if (i % 4 == 0) {
+                system->markVehicleArrived(req);
+                system->markVehicleExited(req);
+            } else if (i % 4 == 1) {
+                system->cancelRequest(req);
+            }
+        }
+        // Occasionally race another gateway for a neighbouring request
+        if (i % 5 == 0) {
+            system->cancelRequest(req - 1);
+        }
+    }
+}
+
+long long runStress(ParkingSystem& system, int gateways, int totalOperations, int zoneCount) {
+    thread* workers = new thread[gateways];
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < gateways; g++) {
+        workers[g] = thread(stressGateway, &system, g, totalOperations / gateways, zoneCount);
+    }
+    for (int g = 0; g < gateways; g++) {
+        workers[g].join();
+    }
+    long long elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    delete[] workers;
+    return elapsed;
+}
+
+void testConcurrentAllocation() {
+    cout << "TEST 22: Concurrent Allocation Stress" << endl;
+    printSeparator();
+    
+    const int zoneCount = 8;
+    const int totalOperations = 24000;
+    int gateways = (int)thread::hardware_concurrency();
+    if (gateways < 2) gateways = 2;
+    if (gateways > 8) gateways = 8;
+    
+    streambuf* original = cout.rdbuf();
+    NullBuffer discard;
+    
+    // Gateways run quiet: lookups are lock-free, the rollback log is striped and
+    // nothing is printed, so the shared locks left are the zone shards and the registry
+    ParkingSystem serial;
+    buildStressCity(serial, zoneCount);
+    serial.setVerbose(false);
+    cout.rdbuf(&discard);
+    long long serialTime = runStress(serial, 1, totalOperations, zoneCount);
+    cout.rdbuf(original);
+    
+    ParkingSystem system;
+    buildStressCity(system, zoneCount);
+    system.setVerbose(false);
+    cout.rdbuf(&discard);
+    long long parallelTime = runStress(system, gateways, totalOperations, zoneCount);
+    cout.rdbuf(original);
+    
+    // Every ALLOCATED/OCCUPIED request must hold a distinct occupied slot
+    int slotCount = system.getSlotDirectory()->getSlotCount();
+    char* held = new char[slotCount];
+    memset(held, 0, slotCount);
+    int holders = 0;
+    int doubleAllocated = 0;
+    bool ownersMatch = true;
+    int lastId = system.getRequestTable()->getNextRequestId();
+    for (int id = 1; id < lastId; id++) {
+        ParkingRequest* request = system.getRequestById(id);
+        if (request == nullptr) continue;
+        if (request->getState() != ALLOCATED && request->getState() != OCCUPIED) continue;
+        
+        int handle = request->getAllocatedSlotHandle();
+        ParkingSlot* slot = system.findSlotByHandle(handle);
+        if (slot == nullptr || slot->getAllocatedVehicleHandle() != request->getVehicleHandle()) {
+            ownersMatch = false;
+            continue;
+        }
+        if (held[handle]) doubleAllocated++;
+        held[handle] = 1;
+        holders++;
+    }
+    delete[] held;
+    
+    SlotStatusCounts actual = system.auditSlotStatuses();
+    const OccupancyCounter* city = system.getCityOccupancy();
+    bool countersMatch = city->getCount(SLOT_OCCUPIED) == actual.occupied &&
+                         city->getAvailableSlots() == actual.available;
+    
+    cout << "Double-allocated slots:       " << doubleAllocated << endl;
+    cout << "Slot owners match requests:   " << (ownersMatch ? "YES" : "NO") << endl;
+    cout << "Holders match occupied slots: " << (holders == actual.occupied ? "YES" : "NO") << endl;
+    cout << "Counters match recount:       " << (countersMatch ? "YES" : "NO") << endl;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << "1 gateway time: " << serialTime << " us" << endl;
+    cout << gateways << " gateways time: " << parallelTime << " us (speedup " 
+         << (parallelTime > 0 ? (double)serialTime / parallelTime : 0.0) << "x)" << endl;
+}
+
+void gateController(GateIngest* ingest, int gate, int vehicles) {
+    // Every car gets a create; then a third park and leave, a third cancel, a third stay
+    char vehicleId[24];
+    for (int i = 0; i < vehicles; i++) {
+        sprintf(vehicleId, "GATE%d-%04d", gate, i);
+        while (!ingest->postCreate(vehicleId, 1 + (gate + i) % 4)) this_thread::yield();
+    }
+    for (int i = 0; i < vehicles; i++) {
+        sprintf(vehicleId, "GATE%d-%04d", gate, i);
+        if (i % 3 == 1) {
+            while (!ingest->postCancel(vehicleId)) this_thread::yield();
+            continue;
+        }
+        while (!ingest->postArrive(vehicleId)) this_thread::yield();
+        if (i % 3 == 0) {
+            while (!ingest->postExit(vehicleId)) this_thread::yield();
+        }
+    }
+}
+
+void testGateIngestion() {
+    cout << "TEST 23: Lock-Free Gate Ingestion Ring" << endl;
+    printSeparator();
+    
+    const int gates = 4;
+    const int vehiclesPerGate = 150;
+    ParkingSystem system;
+    buildStressCity(system, 4);
+    
+    streambuf* original = cout.rdbuf();
+    NullBuffer discard;
+    cout.rdbuf(&discard);
+    
+    // Small ring so producers hit the full case and retry
+    GateIngest ingest(&system, 64);
+    ingest.start();
+    thread* controllers = new thread[gates];
+    for (int g = 0; g < gates; g++) {
+        controllers[g] = thread(gateController, &ingest, g, vehiclesPerGate);
+    }
+    for (int g = 0; g < gates; g++) {
+        controllers[g].join();
+    }
+    delete[] controllers;
+    ingest.stop();
+    cout.rdbuf(original);
+    
+    cout << "Ring capacity:    " << ingest.getCapacity() << endl;
+    cout << "Events posted:    " << ingest.getPostedCount() << endl;
+    cout << "Events applied:   " << ingest.getAppliedCount() 
+         << " (refused " << ingest.getFailedCount() << ")" << endl;
+    cout << "Completed trips:  " << system.getCompletedTrips() << endl;
+    cout << "Cancelled:        " << system.getCancelledRequests() << endl;
+    cout << "Still parked:     " << system.getCityOccupancy()->getCount(SLOT_OCCUPIED) << endl;
+    cout << "Oversized plate rejected: " 
+         << (ingest.postCreate("PLATE-FAR-TOO-LONG-FOR-A-GATE", 1) ? "NO" : "YES") << endl;
+    
+    // Producer-side cost: posting into a ring the consumer is not draining
+    GateIngest idle(&system, 1 << 16);
+    const int posts = 50000;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < posts; i++) {
+        idle.postCancel("NOBODY");
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    cout << "Average post latency: " << (elapsed / posts) << " ns" << endl;
+    
+    cout.rdbuf(&discard);
+    idle.stop();
+    cout.rdbuf(original);
+}
+
+struct BurstTask {
+    atomic<long long>* sum;
+    int value;
+};
+
+void runBurstLeaf(void* context, WorkStealingPool*, int) {
+    BurstTask* task = (BurstTask*)context;
+    long long square = 0;
+    for (int i = 0; i < 20000; i++) {
+        square += (long long)task->value * task->value % (i + 1);
+    }
+    task->sum->fetch_add(square);
+}
+
+void runBurstRoot(void* context, WorkStealingPool* pool, int worker) {
+    // Queue the whole burst on this worker; idle workers have to steal it
+    BurstTask* leaves = (BurstTask*)context;
+    for (int i = 0; i < 64; i++) {
+        pool->spawn(worker, runBurstLeaf, &leaves[i]);
+    }
+}
+
+void testWorkStealingPool() {
+    cout << "TEST 24: Work-Stealing Worker Pool" << endl;
+    printSeparator();
+    
+    // A burst spawned on one worker is drained by all of them
+    {
+        WorkStealingPool pool(4);
+        atomic<long long> parallelSum(0);
+        BurstTask leaves[64];
+        for (int i = 0; i < 64; i++) {
+            leaves[i].sum = &parallelSum;
+            leaves[i].value = i + 1;
+        }
+        pool.submit(runBurstRoot, leaves);
+        pool.waitIdle();
+        
+        atomic<long long> serialSum(0);
+        for (int i = 0; i < 64; i++) {
+            leaves[i].sum = &serialSum;
+            runBurstLeaf(&leaves[i], nullptr, -1);
+        }
+        cout << "Workers: " << pool.getWorkerCount() << ", tasks executed: " << pool.getExecutedCount() << endl;
+        cout << "Burst result matches serial: " << (parallelSum.load() == serialSum.load() ? "YES" : "NO") << endl;
+    }
+    
+    // Zone-parallel batch: same placement totals as the serial greedy batch
+    const int surge = 700;
+    ParkingSystem system;
+    buildSurgeCity(system);
+    system.startWorkerPool(4);
+    for (int i = 0; i < surge; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "SURGE%04d", i);
+        system.submitRequest(vehicleId, (i % 10 < 6) ? 1 : (i % 10 < 8) ? 2 : 3);
+    }
+    auto start = chrono::steady_clock::now();
+    BatchAllocationResult result = system.processPendingRequests();
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    int holders = 0;
+    bool consistent = true;
+    for (int id = 1; id <= surge; id++) {
+        ParkingRequest* request = system.getRequestById(id);
+        if (request == nullptr || request->getState() != ALLOCATED) continue;
+        ParkingSlot* slot = system.findSlotByHandle(request->getAllocatedSlotHandle());
+        if (slot == nullptr || slot->getAllocatedVehicleHandle() != request->getVehicleHandle()) {
+            consistent = false;
+        }
+        holders++;
+    }
+    consistent = consistent && holders == result.allocated() &&
+                 holders == system.getCityOccupancy()->getCount(SLOT_OCCUPIED);
+    cout << "Parallel batch same-zone / cross-zone: " << result.sameZone << " / " << result.crossZone << endl;
+    cout << "Parallel batch consistent: " << (consistent ? "YES" : "NO") << endl;
+    cout << "Parallel batch time: " << elapsed << " us" << endl;
+    
+    // Zone statistics computed as pool tasks match the serial pass
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int id = 1; id <= 90; id += 3) {
+        system.markVehicleArrived(id);
+        system.markVehicleExited(id);
+        system.cancelRequest(id + 1);
+    }
+    cout.rdbuf(original);
+    DynamicArray<ZoneStats> parallelStats = system.getAnalyticsEngine()->getZoneStatistics();
+    system.stopWorkerPool();
+    DynamicArray<ZoneStats> serialStats = system.getAnalyticsEngine()->getZoneStatistics();
+    bool statsMatch = parallelStats.getSize() == serialStats.getSize();
+    for (int i = 0; statsMatch && i < serialStats.getSize(); i++) {
+        statsMatch = parallelStats[i].zoneId == serialStats[i].zoneId &&
+                     parallelStats[i].totalTripsCompleted == serialStats[i].totalTripsCompleted &&
+                     parallelStats[i].totalTripsCancelled == serialStats[i].totalTripsCancelled &&
+                     parallelStats[i].currentOccupied == serialStats[i].currentOccupied;
+    }
+    cout << "Zone 1 trips completed / cancelled: " << serialStats[0].totalTripsCompleted 
+         << " / " << serialStats[0].totalTripsCancelled << endl;
+    cout << "Parallel zone stats match serial: " << (statsMatch ? "YES" : "NO") << endl;
+}
+
+void testZoneActors() {
+    cout << "TEST 25: Per-Zone Actor Mode" << endl;
+    printSeparator();
+    
+    // Same surge as test 19, placed by three zone actors
+    const int surge = 700;
+    ParkingSystem system;
+    buildSurgeCity(system);
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < surge; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "ACTOR%04d", i);
+        system.createRequest(vehicleId, (i % 10 < 6) ? 1 : (i % 10 < 8) ? 2 : 3);
+    }
+    cout.rdbuf(original);
+    
+    ZoneActorSystem actors(&system, 1024);
+    actors.start();
+    auto start = chrono::steady_clock::now();
+    int accepted = 0;
+    for (int id = 1; id <= surge; id++) {
+        if (actors.allocate(id)) accepted++;
+    }
+    actors.waitIdle();
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    int holders = 0;
+    bool consistent = true;
+    for (int id = 1; id <= surge; id++) {
+        ParkingRequest* request = system.getRequestById(id);
+        if (request == nullptr || request->getState() != ALLOCATED) continue;
+        ParkingSlot* slot = system.findSlotByHandle(request->getAllocatedSlotHandle());
+        if (slot == nullptr || slot->getAllocatedVehicleHandle() != request->getVehicleHandle()) {
+            consistent = false;
+        }
+        holders++;
+    }
+    long long placed = actors.getSameZoneCount() + actors.getCrossZoneCount();
+    cout << "Actors: " << actors.getActorCount() << ", requests accepted: " << accepted << endl;
+    cout << "Placed / unplaced: " << placed << " / " << actors.getFailedCount() << endl;
+    cout << "Forwards cover cross-zone placements: " 
+         << (actors.getForwardedCount() >= actors.getCrossZoneCount() ? "YES" : "NO") << endl;
+    cout << "Slots owned by their requests: " 
+         << (consistent && holders == placed && holders == system.getCityOccupancy()->getCount(SLOT_OCCUPIED) ? "YES" : "NO") << endl;
+    cout << "Actor placement time: " << elapsed << " us" << endl;
+    
+    // Exits and cancels go to the owning actor's mailbox too: 25 arrive and
+    // leave, 25 are withdrawn; all 50 must end with their slots and class charges
+    int exited = 0;
+    int cancelled = 0;
+    long long occupiedBefore = system.getCityOccupancy()->getCount(SLOT_OCCUPIED);
+    int heldBefore = 0;
+    for (int z = 1; z <= 3; z++) heldBefore += system.getZoneById(z)->getClassHeld(CLASS_STANDARD);
+    DynamicArray<int> leaving;
+    for (int id = 1; id <= surge && leaving.getSize() < 50; id++) {
+        ParkingRequest* request = system.getRequestById(id);
+        if (request == nullptr || request->getState() != ALLOCATED) continue;
+        if (leaving.getSize() < 25) {
+            system.markVehicleArrived(id);
+            if (actors.exit(id)) exited++;
+        } else if (actors.cancel(id)) {
+            cancelled++;
+        }
+        leaving.add(id);
+    }
+    actors.stop();
+    bool allEnded = true;
+    for (int i = 0; i < leaving.getSize(); i++) {
+        const ArchivedRequest* archived = system.getArchivedRequest(leaving[i]);
+        if (system.getRequestById(leaving[i]) != nullptr || archived == nullptr ||
+            archived->finalState != (i < 25 ? RELEASED : CANCELLED)) {
+            allEnded = false;
+        }
+    }
+    int heldAfter = 0;
+    for (int z = 1; z <= 3; z++) heldAfter += system.getZoneById(z)->getClassHeld(CLASS_STANDARD);
+    cout << "Exited / cancelled through actors: " << exited << " / " << cancelled 
+         << ", applied: " << actors.getReleasedCount() << endl;
+    cout << "Requests ended: " << (allEnded ? "YES" : "NO") << ", slots freed: " 
+         << (occupiedBefore - system.getCityOccupancy()->getCount(SLOT_OCCUPIED)) 
+         << ", class charges refunded: " << (heldBefore - heldAfter) << endl;
+}
+
+void testNoShowExpiry() {
+    cout << "TEST 26: No-Show Expiry (Timing Wheel)" << endl;
+    printSeparator();
+    
+    // Wheel alone: a million timers over ~28 hours of one-second ticks, half cancelled
+    const int timerCount = 1000000;
+    const int horizon = 100000;
+    TimingWheel wheel(0);
+    TimerHandle* handles = new TimerHandle[timerCount];
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < timerCount; i++) {
+        int deadline = (int)(((long long)i * 7919) % horizon) + 1;
+        handles[i] = wheel.schedule(deadline, deadline);
+    }
+    int cancelled = 0;
+    for (int i = 0; i < timerCount; i += 2) {
+        if (wheel.cancel(handles[i])) cancelled++;
+    }
+    bool staleRejected = !wheel.cancel(handles[0]) && !wheel.isPending(handles[0]);
+    
+    DynamicArray<ExpiredTimer> expired(1024);
+    int fired = 0;
+    bool onTime = true;
+    for (long long now = 997, previous = 0; previous < horizon; previous = now, now += 997) {
+        expired.clear();
+        fired += wheel.advance(now, expired);
+        for (int i = 0; i < expired.getSize(); i++) {
+            if (expired[i].payload <= previous || expired[i].payload > now) onTime = false;
+        }
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    delete[] handles;
+    cout << "Timers scheduled / cancelled / fired: " << timerCount << " / " << cancelled 
+         << " / " << fired << endl;
+    cout << "Every timer fired within its tick window: " << (onTime ? "YES" : "NO") << endl;
+    cout << "Stale handle rejected: " << (staleRejected ? "YES" : "NO") 
+         << ", still pending: " << wheel.getActiveCount() << endl;
+    cout << "Wheel time: " << elapsed << " ms" << endl;
+    
+    // System: 20 direct + 5 batch allocations, 8 arrive, 2 cancel, the rest never show
+    ParkingSystem system;
+    buildSurgeCity(system);
+    system.setNoShowTimeout(600);
+    long long now = time(nullptr);
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 20; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "NOSHOW%02d", i);
+        system.processRequest(system.createRequest(vehicleId, 1 + i % 3));
+    }
+    for (int i = 0; i < 5; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "BATCHNS%02d", i);
+        system.submitRequest(vehicleId, 2);
+    }
+    system.processPendingRequests();
+    for (int id = 1; id <= 8; id++) {
+        system.markVehicleArrived(id);
+    }
+    system.cancelRequest(9);
+    system.cancelRequest(10);
+    cout.rdbuf(original);
+    
+    cout << "Timers armed after arrivals and cancels: " << system.getPendingNoShowTimers() << endl;
+    cout << "Expired before the deadline: " << system.expireNoShows(now + 599) << endl;
+    int expiredCount = system.expireNoShows(now + 700);
+    cout << "Expired after the deadline: " << expiredCount 
+         << " (total no-shows: " << system.getNoShowCount() << ")" << endl;
+    
+    const ArchivedRequest* archived = system.getArchivedRequest(25);
+    cout << "Batch no-show archived as: " 
+         << (archived != nullptr ? StateValidator::getStateString(archived->finalState) : "missing") << endl;
+    cout << "Occupied slots left: " << system.getCityOccupancy()->getCount(SLOT_OCCUPIED)
+         << ", timers left: " << system.getPendingNoShowTimers() << endl;
+    cout << "Arrived vehicle kept its slot: " 
+         << (system.getRequestById(1) != nullptr && system.getRequestById(1)->getState() == OCCUPIED ? "YES" : "NO") << endl;
+}
+
+struct OverstayLog {
+    int fired;
+    long long worstOverdue;
+};
+
+void recordOverstay(int, long long overdueSeconds, void* context) {
+    OverstayLog* log = (OverstayLog*)context;
+    log->fired++;
+    if (overdueSeconds > log->worstOverdue) {
+        log->worstOverdue = overdueSeconds;
+    }
+}
+
+void testOverstayDetection() {
+    cout << "TEST 27: Overstay Detection (Indexed Min-Heap)" << endl;
+    printSeparator();
+    
+    // Heap alone: pushes, re-keys and removals by id, then pops come out in key order
+    const int entryCount = 200000;
+    IndexedMinHeap heap;
+    auto start = chrono::steady_clock::now();
+    for (int id = 0; id < entryCount; id++) {
+        heap.push(id, ((long long)id * 7919) % 100003);
+    }
+    for (int id = 0; id < entryCount; id += 3) {
+        heap.push(id, ((long long)id * 104729) % 100003);      // Re-key
+    }
+    int removed = 0;
+    for (int id = 1; id < entryCount; id += 4) {
+        if (heap.remove(id)) removed++;
+    }
+    bool ordered = true;
+    long long previous = -1;
+    int popped = 0;
+    while (!heap.isEmpty()) {
+        long long key = heap.topKey();
+        if (key < previous) ordered = false;
+        previous = key;
+        heap.pop();
+        popped++;
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    cout << "Heap entries / removed / popped: " << entryCount << " / " << removed << " / " << popped << endl;
+    cout << "Pops in key order: " << (ordered ? "YES" : "NO") << endl;
+    cout << "Heap time: " << elapsed << " ms" << endl;
+    
+    // System: 30 parked vehicles - 10 booked for 10 minutes (5 leave on time),
+    // 10 booked for 2 hours, 10 on the 1-hour default
+    ParkingSystem system;
+    buildSurgeCity(system);
+    system.setDefaultStayDuration(60 * 60);
+    OverstayLog log = {0, 0};
+    system.setOverstayCallback(recordOverstay, &log);
+    long long now = time(nullptr);
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 30; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "STAY%02d", i);
+        int requestId = system.createRequest(vehicleId, 1 + i % 3);
+        system.processRequest(requestId);
+        if (i < 10) system.setBookedDuration(requestId, 10 * 60);
+        else if (i < 20) system.setBookedDuration(requestId, 2 * 60 * 60);
+        system.markVehicleArrived(requestId);
+    }
+    for (int id = 1; id <= 5; id++) {
+        system.markVehicleExited(id);
+    }
+    cout.rdbuf(original);
+    
+    DynamicArray<int> overstays;
+    cout << "Tracked stays: " << system.getTrackedStayCount() << endl;
+    cout << "New overstays at +1000 s: " << system.checkOverstays(now + 1000) 
+         << ", repeated check: " << system.checkOverstays(now + 1000) << endl;
+    system.setBookedDuration(6, 3 * 60 * 60);
+    cout << "Current overstays after extending request 6: " 
+         << system.collectOverstays(now + 1000, overstays) << endl;
+    cout << "New overstays at +4000 s: " << system.checkOverstays(now + 4000) << endl;
+    cout << "Callbacks fired: " << log.fired 
+         << ", worst overdue within bounds: " << (log.worstOverdue >= 398 && log.worstOverdue <= 400 ? "YES" : "NO") << endl;
+}
+
+void testWaitlistHandoff() {
+    cout << "TEST 28: Waitlists with Release-Triggered Handoff" << endl;
+    printSeparator();
+    
+    // Two 2-slot zones side by side, both full
+    ParkingSystem system;
+    Zone* north = new Zone(1, "North");
+    north->addParkingArea(new ParkingArea(11, 1, "North Lot", 2));
+    system.addZone(north);
+    Zone* south = new Zone(2, "South");
+    south->addParkingArea(new ParkingArea(21, 2, "South Lot", 2));
+    system.addZone(south);
+    north->addAdjacentZone(2);
+    south->addAdjacentZone(1);
+    system.setWaitlistEnabled(true);
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int parked[4];
+    for (int i = 0; i < 4; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "FULL%d", i);
+        parked[i] = system.createRequest(vehicleId, i < 2 ? 1 : 2);
+        system.processRequest(parked[i]);
+    }
+    int early = system.createRequest("WAIT-EARLY", 1);
+    int vip = system.createRequest("WAIT-VIP", 1);
+    int southWaiter = system.createRequest("WAIT-SOUTH", 2);
+    system.setRequestPriority(vip, 5);
+    bool anyPlaced = system.processRequest(early) | system.processRequest(vip) | 
+                     system.processRequest(southWaiter);
+    cout.rdbuf(original);
+    cout << "Waiters placed immediately: " << (anyPlaced ? "YES" : "NO") 
+         << ", waitlist lengths: " << system.getWaitlistLength(1) << " / " << system.getWaitlistLength(2) << endl;
+    
+    // Exit in North goes to the higher-priority waiter even though it asked later
+    system.markVehicleArrived(parked[0]);
+    system.markVehicleExited(parked[0]);
+    cout << "VIP served first: " << (system.getRequestById(vip)->getState() == ALLOCATED &&
+                                     system.getRequestById(early)->getState() == REQUESTED ? "YES" : "NO") << endl;
+    
+    // A cancel in South serves South's own waiter; a cancel in North serves the early waiter
+    system.cancelRequest(parked[2]);
+    system.cancelRequest(parked[1]);
+    cout << "South and early waiters served: " 
+         << (system.getRequestById(southWaiter)->getState() == ALLOCATED && 
+             system.getRequestById(early)->getState() == ALLOCATED ? "YES" : "NO") << endl;
+    
+    // South has no waiters left, so its next free slot goes to a North waiter
+    cout.rdbuf(sink.rdbuf());
+    int overflow = system.createRequest("WAIT-OVERFLOW", 1);
+    system.processRequest(overflow);
+    int quitter = system.createRequest("WAIT-QUIT", 1);
+    system.processRequest(quitter);
+    system.cancelRequest(quitter);
+    cout.rdbuf(original);
+    system.cancelRequest(southWaiter);
+    ParkingRequest* moved = system.getRequestById(overflow);
+    cout << "North waiter took the South slot cross-zone: " 
+         << (moved->getState() == ALLOCATED && moved->isCrossZone() ? "YES" : "NO") << endl;
+    cout << "Cancelled waiter left the list: " << (system.getWaitlistLength(1) == 0 ? "YES" : "NO")
+         << ", handoffs: " << system.getHandoffCount() << endl;
+    
+    // Rollback detaches the allocation before handing its slot to a waiter:
+    // the rolled-back request's no-show timer must not later free the slot
+    ParkingSystem booth;
+    Zone* single = new Zone(1, "Single");
+    single->addParkingArea(new ParkingArea(11, 1, "One Bay", 1));
+    booth.addZone(single);
+    booth.setWaitlistEnabled(true);
+    booth.setNoShowTimeout(60);
+    cout.rdbuf(sink.rdbuf());
+    int first = booth.createRequest("RB-A", 1);
+    booth.processRequest(first);
+    int waiter = booth.createRequest("RB-B", 1);
+    booth.processRequest(waiter);
+    booth.rollbackOperations(1);
+    booth.markVehicleArrived(waiter);
+    int expiredAfter = booth.expireNoShows(time(nullptr) + 3600);
+    bool latePlaced = booth.processRequest(booth.createRequest("RB-C", 1));
+    cout.rdbuf(original);
+    ParkingRequest* rolledBack = booth.getRequestById(first);
+    cout << "Rolled-back request: " << rolledBack->getStateString() << ", slot " << rolledBack->getAllocatedSlotId()
+         << "; waiter " << booth.getRequestById(waiter)->getStateString() << " in slot " 
+         << booth.getRequestById(waiter)->getAllocatedSlotId() << endl;
+    cout << "No-shows expired afterwards: " << expiredAfter << ", late request placed in the occupied bay: "
+         << (latePlaced ? "YES" : "NO") << endl;
+    
+    // Scale: a full 600-slot city, 300 waiters, 300 departures - no retries needed
+    ParkingSystem city;
+    buildSurgeCity(city);
+    city.setWaitlistEnabled(true);
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 900; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "CITY%04d", i);
+        int requestId = city.createRequest(vehicleId, 1 + i % 3);
+        if (i >= 600) city.setRequestPriority(requestId, i % 4);
+        city.processRequest(requestId);
+        if (i < 600) city.markVehicleArrived(requestId);
+    }
+    auto start = chrono::steady_clock::now();
+    for (int id = 1; id <= 600; id += 2) {
+        city.markVehicleExited(id);
+    }
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    int waiting = city.getWaitlistLength(1) + city.getWaitlistLength(2) + city.getWaitlistLength(3);
+    cout << "City handoffs: " << city.getHandoffCount() << ", still waiting: " << waiting 
+         << ", occupied: " << city.getCityOccupancy()->getCount(SLOT_OCCUPIED) << endl;
+    cout << "Departure + handoff time: " << elapsed << " us" << endl;
+}
+
+void testPriorityClasses() {
+    cout << "TEST 29: Priority Classes and Reserved Capacity" << endl;
+    printSeparator();
+    
+    // One isolated 10-slot zone: 2 slots held for accessibility, 1 for emergencies
+    ParkingSystem system;
+    Zone* plaza = new Zone(1, "Plaza");
+    plaza->addParkingArea(new ParkingArea(11, 1, "Plaza Lot", 10));
+    system.addZone(plaza);
+    system.setReservedCapacity(1, CLASS_ACCESSIBILITY, 2);
+    system.setReservedCapacity(1, CLASS_EMERGENCY, 1);
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int standardPlaced = 0;
+    for (int i = 0; i < 8; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "STD%d", i);
+        if (system.processRequest(system.createRequest(vehicleId, 1))) standardPlaced++;
+    }
+    bool permitPlaced = system.processRequest(system.createRequest("PERMIT1", 1, CLASS_PERMIT));
+    int accessiblePlaced = 0;
+    for (int i = 0; i < 3; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "ACCESS%d", i);
+        if (system.processRequest(system.createRequest(vehicleId, 1, CLASS_ACCESSIBILITY))) accessiblePlaced++;
+    }
+    bool emergencyPlaced = system.processRequest(system.createRequest("EMERG1", 1, CLASS_EMERGENCY));
+    cout.rdbuf(original);
+    
+    cout << "Standard placed: " << standardPlaced << " of 8, permit placed: " << (permitPlaced ? "YES" : "NO") << endl;
+    cout << "Accessibility placed: " << accessiblePlaced << " of 3, emergency placed: " 
+         << (emergencyPlaced ? "YES" : "NO") << endl;
+    cout << "Held per class (std/permit/access/emerg): " << plaza->getClassHeld(CLASS_STANDARD) << "/" 
+         << plaza->getClassHeld(CLASS_PERMIT) << "/" << plaza->getClassHeld(CLASS_ACCESSIBILITY) << "/"
+         << plaza->getClassHeld(CLASS_EMERGENCY) << ", free: " << plaza->getOccupancy()->getAvailableSlots() << endl;
+    
+    // Releasing a standard slot returns it to general capacity; reserves are all in use
+    cout.rdbuf(sink.rdbuf());
+    system.markVehicleArrived(1);
+    system.markVehicleExited(1);
+    bool standardAgain = system.processRequest(system.createRequest("STD-LATE", 1));
+    cout.rdbuf(original);
+    cout << "Standard admitted after a standard exit: " << (standardAgain ? "YES" : "NO") 
+         << ", standard held: " << plaza->getClassHeld(CLASS_STANDARD) << endl;
+    
+    // A rolled-back permit allocation gives its reserved slot back to the permit class
+    ParkingSystem kiosk;
+    Zone* kerb = new Zone(1, "Kerb");
+    kerb->addParkingArea(new ParkingArea(11, 1, "Kerb Bays", 3));
+    kiosk.addZone(kerb);
+    kiosk.setReservedCapacity(1, CLASS_PERMIT, 1);
+    cout.rdbuf(sink.rdbuf());
+    kiosk.processRequest(kiosk.createRequest("PERMIT-RB", 1, CLASS_PERMIT));
+    kiosk.rollbackOperations(1);
+    int permitHeld = kerb->getClassHeld(CLASS_PERMIT);
+    int kerbPlaced = 0;
+    for (int i = 0; i < 3; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "KERB%d", i);
+        if (kiosk.processRequest(kiosk.createRequest(vehicleId, 1))) kerbPlaced++;
+    }
+    cout.rdbuf(original);
+    cout << "Permit held after rollback: " << permitHeld << ", standard placed in 3-slot zone: " 
+         << kerbPlaced << " (1 kept for permits)" << endl;
+    
+    // Waitlist: a standard waiter ahead of a permit waiter does not keep it
+    // from the slot a permit exit returns to the permit reserve
+    ParkingSystem gate;
+    Zone* gateLot = new Zone(1, "Gate");
+    gateLot->addParkingArea(new ParkingArea(11, 1, "Gate Bays", 3));
+    gate.addZone(gateLot);
+    gate.setReservedCapacity(1, CLASS_PERMIT, 1);
+    gate.setWaitlistEnabled(true);
+    cout.rdbuf(sink.rdbuf());
+    gate.processRequest(gate.createRequest("GATE-STD1", 1));
+    gate.processRequest(gate.createRequest("GATE-STD2", 1));
+    int permitLeaving = gate.createRequest("GATE-PERMIT", 1, CLASS_PERMIT);
+    gate.processRequest(permitLeaving);
+    int standardWaiter = gate.createRequest("WAIT-STD", 1);
+    gate.processRequest(standardWaiter);
+    int permitWaiter = gate.createRequest("WAIT-PERMIT", 1, CLASS_PERMIT);
+    gate.processRequest(permitWaiter);
+    gate.markVehicleArrived(permitLeaving);
+    gate.markVehicleExited(permitLeaving);
+    cout.rdbuf(original);
+    cout << "Permit exit handed to the permit waiter behind a standard one: " 
+         << (gate.getRequestById(permitWaiter)->getState() == ALLOCATED ? "YES" : "NO")
+         << ", standard still waiting: " << gate.getWaitlistLength(1) << endl;
+    
+    // Multi-level batch queue: emergencies submitted last are served first
+    ParkingSystem depot;
+    Zone* yard = new Zone(1, "Yard");
+    yard->addParkingArea(new ParkingArea(11, 1, "Yard Lot", 4));
+    depot.addZone(yard);
+    int emergencyIds[3];
+    for (int i = 0; i < 5; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "QSTD%d", i);
+        depot.submitRequest(vehicleId, 1);
+    }
+    for (int i = 0; i < 3; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "QEMERG%d", i);
+        emergencyIds[i] = depot.submitRequest(vehicleId, 1, CLASS_EMERGENCY);
+    }
+    cout.rdbuf(sink.rdbuf());
+    BatchAllocationResult result = depot.processPendingRequests();
+    cout.rdbuf(original);
+    bool emergenciesFirst = true;
+    for (int i = 0; i < 3; i++) {
+        if (depot.getRequestById(emergencyIds[i])->getState() != ALLOCATED) emergenciesFirst = false;
+    }
+    cout << "Batch allocated " << result.allocated() << " of " << result.processed 
+         << ", all emergencies placed: " << (emergenciesFirst ? "YES" : "NO") 
+         << ", re-queued: " << depot.getPendingCount() << endl;
+}
+
+void testAdvanceReservations() {
+    cout << "TEST 30: Advance Reservations (SLOT_RESERVED)" << endl;
+    printSeparator();
+    
+    // Ten-slot lot; six bookings from 1 h to 3 h after the next quarter hour
+    ParkingSystem system;
+    Zone* lot = new Zone(1, "Venue Lot");
+    lot->addParkingArea(new ParkingArea(11, 1, "Lot A", 10));
+    system.addZone(lot);
+    long long now = time(nullptr);
+    long long base = (now / 900 + 1) * 900;
+    long long eventStart = base + 60 * 60;
+    long long eventEnd = base + 3 * 60 * 60;
+    int booked = 0;
+    for (int i = 0; i < 6; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "GUEST%d", i);
+        if (system.reserve(vehicleId, 1, eventStart, eventEnd) >= 0) booked++;
+    }
+    cout << "Bookings: " << booked << ", 3-hour window still open: " 
+         << (system.isZoneAvailable(1, eventStart, eventEnd) ? "YES" : "NO") << endl;
+    
+    // Walk-ins staying 2 h would run into the event, so six slots are held back
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int walkIns = 0;
+    for (int i = 0; i < 6; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "WALKIN%d", i);
+        if (system.processRequest(system.createRequest(vehicleId, 1))) walkIns++;
+    }
+    system.setDefaultStayDuration(30 * 60);
+    bool shortStay = system.processRequest(system.createRequest("QUICKSTOP", 1));
+    cout.rdbuf(original);
+    cout << "2-hour walk-ins admitted: " << walkIns << " of 6, 30-minute walk-in admitted: " 
+         << (shortStay ? "YES" : "NO") << endl;
+    
+    // Zone actors hold the same six slots back from 2-hour walk-ins
+    ParkingSystem arena;
+    Zone* arenaLot = new Zone(1, "Arena Lot");
+    arenaLot->addParkingArea(new ParkingArea(11, 1, "Lot A", 10));
+    arena.addZone(arenaLot);
+    for (int i = 0; i < 6; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "GUEST%d", i);
+        arena.reserve(vehicleId, 1, eventStart, eventEnd);
+    }
+    cout.rdbuf(sink.rdbuf());
+    ZoneActorSystem actors(&arena);
+    actors.start();
+    for (int i = 0; i < 6; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "WALKIN%d", i);
+        actors.allocate(arena.createRequest(vehicleId, 1));
+    }
+    int heldUnderActors = arena.advanceReservations(eventStart - 15 * 60);
+    actors.stop();
+    int heldAfterStop = arena.advanceReservations(eventStart - 15 * 60);
+    cout.rdbuf(original);
+    cout << "2-hour walk-ins admitted by zone actors: " << actors.getSameZoneCount() << " of 6" << endl;
+    cout << "Holds placed while actors run: " << heldUnderActors << ", after stop: " << heldAfterStop << endl;
+    
+    // Selling the window out to ten bookings refuses an eleventh; cancelling reopens it
+    int extra = 0;
+    for (int i = 6; i < 10; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "GUEST%d", i);
+        if (system.reserve(vehicleId, 1, eventStart, eventEnd) >= 0) extra++;
+    }
+    bool eleventh = system.reserve("GUEST10", 1, eventStart + 1800, eventStart + 3600) >= 0;
+    cout << "Extra bookings: " << extra << ", eleventh accepted: " << (eleventh ? "YES" : "NO")
+         << ", later window open: " << (system.isZoneAvailable(1, eventEnd, eventEnd + 3600) ? "YES" : "NO") << endl;
+    for (int i = 6; i < 10; i++) {
+        system.cancelReservation(i);
+    }
+    cout << "Window reopened after cancelling extras: " 
+         << (system.isZoneAvailable(1, eventStart, eventEnd) ? "YES" : "NO") << endl;
+    
+    // Fifteen minutes before the event the six bookings get real slots
+    const OccupancyCounter* city = system.getCityOccupancy();
+    int held = system.advanceReservations(eventStart - 15 * 60);
+    cout << "Slots held: " << held << ", reserved now: " << city->getCount(SLOT_RESERVED) << endl;
+    
+    cout.rdbuf(sink.rdbuf());
+    int requestId = system.checkInReservation(0);
+    cout.rdbuf(original);
+    bool checkedIn = requestId >= 0 && system.getRequestById(requestId)->getState() == ALLOCATED;
+    system.cancelReservation(1);
+    cout << "Check-in allocated the held slot: " << (checkedIn ? "YES" : "NO") 
+         << ", reserved after check-in and cancel: " << city->getCount(SLOT_RESERVED) << endl;
+    int expired = system.advanceReservations(eventStart + 15 * 60 + 1);
+    cout << "Unclaimed holds expired: " << expired << ", reserved now: " << city->getCount(SLOT_RESERVED)
+         << ", reservation 2 state: " 
+         << (system.getReservationState(2) == RESERVATION_EXPIRED ? "EXPIRED" : "OTHER") << endl;
+    
+    // Maintenance slots and permit reserves are not sold, and holds leave the reserve alone
+    ParkingSystem depot;
+    Zone* depotLot = new Zone(1, "Depot Lot");
+    ParkingArea* depotArea = new ParkingArea(11, 1, "Lot A", 10);
+    depotLot->addParkingArea(depotArea);
+    depot.addZone(depotLot);
+    depotArea->getSlotByIndex(9)->setStatus(SLOT_MAINTENANCE);
+    depotArea->getSlotByIndex(8)->setStatus(SLOT_MAINTENANCE);
+    depot.setReservedCapacity(1, CLASS_PERMIT, 3);
+    cout.rdbuf(sink.rdbuf());
+    int sold = 0;
+    for (int i = 0; i < 7; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "CREW%d", i);
+        if (depot.reserve(vehicleId, 1, eventStart, eventEnd) >= 0) sold++;
+    }
+    for (int i = 0; i < 3; i++) {
+        depotArea->getSlotByIndex(i)->setStatus(SLOT_MAINTENANCE);
+    }
+    int depotHolds = depot.advanceReservations(eventStart - 15 * 60);
+    cout.rdbuf(original);
+    cout << "Bookings sold on 8 in-service slots with 3 for permits: " << sold << " of 7"
+         << ", holds after 3 more slots left service: " << depotHolds
+         << ", free slots kept for permits: " << depotLot->getAdmissibleSlots(CLASS_PERMIT) << endl;
+    
+    // A held slot taken out of service fails check-in without leaving a request behind
+    ParkingSystem booth;
+    Zone* boothLot = new Zone(1, "Booth Lot");
+    ParkingArea* boothArea = new ParkingArea(11, 1, "Lot A", 2);
+    boothLot->addParkingArea(boothArea);
+    booth.addZone(boothLot);
+    int lateId = booth.reserve("LATECOMER", 1, eventStart, eventEnd);
+    booth.advanceReservations(eventStart - 15 * 60);
+    for (int i = 0; i < 2; i++) {
+        if (boothArea->getSlotByIndex(i)->getStatus() == SLOT_RESERVED) {
+            boothArea->getSlotByIndex(i)->setStatus(SLOT_MAINTENANCE);
+        }
+    }
+    cout.rdbuf(sink.rdbuf());
+    int lateRequest = booth.checkInReservation(lateId);
+    cout.rdbuf(original);
+    int lateExpired = booth.advanceReservations(eventStart + 15 * 60 + 1);
+    cout << "Check-in on a slot moved to maintenance: " << (lateRequest < 0 ? "REFUSED" : "ALLOCATED")
+         << ", live request left: " << (booth.findRequestByVehicle("LATECOMER") != nullptr ? "YES" : "NO")
+         << ", hold expired: " << lateExpired << " ("
+         << (booth.getReservationState(lateId) == RESERVATION_EXPIRED ? "EXPIRED" : "OTHER") << ")" << endl;
+    
+    // Scale: 40,000 bookings over a month against a 1,000-slot venue
+    ParkingSystem venue;
+    Zone* stadium = new Zone(1, "Stadium");
+    for (int a = 0; a < 10; a++) {
+        stadium->addParkingArea(new ParkingArea(10 + a, 1, "Stand", 100));
+    }
+    venue.addZone(stadium);
+    cout.rdbuf(sink.rdbuf());
+    auto start = chrono::steady_clock::now();
+    int accepted = 0;
+    for (int i = 0; i < 40000; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "FAN%05d", i);
+        long long day = base + (long long)(i % 30) * 24 * 60 * 60;
+        long long from = day + (long long)((i * 7) % 48) * 15 * 60;
+        if (venue.reserve(vehicleId, 1, from, from + 10 * 60 * 60) >= 0) accepted++;
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    cout << "Venue bookings accepted: " << accepted << " of 40000" << endl;
+    cout << "Booking time: " << elapsed << " ms" << endl;
+}
+
+void testAttributeAllocation() {
+    cout << "TEST 31: Attribute-Aware Allocation (EV, Accessible, Oversize)" << endl;
+    printSeparator();
+    
+    // Garage: 20 accessible bays in area 11, an EV charger every 50th bay in area 12.
+    // Annex (adjacent) has one bay that is both.
+    ParkingSystem system;
+    Zone* garage = new Zone(1, "Garage");
+    garage->addParkingArea(new ParkingArea(11, 1, "Level 1", 500));
+    garage->addParkingArea(new ParkingArea(12, 1, "Level 2", 500));
+    Zone* annex = new Zone(2, "Annex");
+    annex->addParkingArea(new ParkingArea(21, 2, "Annex Lot", 100));
+    system.addZone(garage);
+    system.addZone(annex);
+    garage->addAdjacentZone(2);
+    annex->addAdjacentZone(1);
+    for (int i = 0; i < 20; i++) {
+        system.setSlotAttributes(11000 + i, ATTR_ACCESSIBLE);
+    }
+    for (int i = 0; i < 500; i += 50) {
+        system.setSlotAttributes(12000 + i, ATTR_EV_CHARGER);
+    }
+    system.setSlotAttributes(21005, ATTR_EV_CHARGER | ATTR_ACCESSIBLE);
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int evId = system.createRequest("EV-1", 1);
+    system.setRequiredAttributes(evId, ATTR_EV_CHARGER);
+    system.processRequest(evId);
+    int bothId = system.createRequest("EV-ACCESS", 1);
+    system.setRequiredAttributes(bothId, ATTR_EV_CHARGER | ATTR_ACCESSIBLE);
+    system.processRequest(bothId);
+    int vanId = system.createRequest("VAN-1", 1);
+    system.setRequiredAttributes(vanId, ATTR_OVERSIZE);
+    bool vanPlaced = system.processRequest(vanId);
+    cout.rdbuf(original);
+    
+    ParkingRequest* ev = system.getRequestById(evId);
+    ParkingRequest* both = system.getRequestById(bothId);
+    cout << "EV request got slot " << ev->getAllocatedSlotId() << " (charger: " 
+         << (system.findSlotByHandle(ev->getAllocatedSlotHandle())->hasAttributes(ATTR_EV_CHARGER) ? "YES" : "NO") << ")" << endl;
+    cout << "EV + accessible request got slot " << both->getAllocatedSlotId() 
+         << (both->isCrossZone() ? " (cross-zone)" : "") << endl;
+    cout << "Oversize request placed: " << (vanPlaced ? "YES" : "NO") << endl;
+    
+    // Batch: every third of 30 requests needs a charger; 9 chargers remain
+    int batchIds[30];
+    for (int i = 0; i < 30; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "BATCH%d", i);
+        batchIds[i] = system.submitRequest(vehicleId, 1);
+        if (i % 3 == 0) system.setRequiredAttributes(batchIds[i], ATTR_EV_CHARGER);
+    }
+    cout.rdbuf(sink.rdbuf());
+    BatchAllocationResult result = system.processPendingRequests();
+    cout.rdbuf(original);
+    int mismatched = 0;
+    int chargersUsed = 0;
+    for (int i = 0; i < 30; i++) {
+        ParkingRequest* request = system.getRequestById(batchIds[i]);
+        if (request->getState() != ALLOCATED) continue;
+        ParkingSlot* slot = system.findSlotByHandle(request->getAllocatedSlotHandle());
+        if (!slot->hasAttributes(request->getRequiredAttributes())) mismatched++;
+        if (request->getRequiredAttributes() != 0) chargersUsed++;
+    }
+    cout << "Batch allocated " << result.allocated() << " of 30, EV placed: " << chargersUsed 
+         << ", slots missing a required attribute: " << mismatched << endl;
+    
+    // Waitlist: an EV waiter at the head is passed over for a plain bay, not dropped
+    ParkingSystem kiosk;
+    Zone* stand = new Zone(1, "Kiosk");
+    stand->addParkingArea(new ParkingArea(11, 1, "Kiosk Bays", 2));
+    kiosk.addZone(stand);
+    kiosk.setSlotAttributes(11001, ATTR_EV_CHARGER);
+    kiosk.setWaitlistEnabled(true);
+    cout.rdbuf(sink.rdbuf());
+    int plainA = kiosk.createRequest("PLAIN-A", 1);
+    kiosk.processRequest(plainA);
+    int plainB = kiosk.createRequest("PLAIN-B", 1);
+    kiosk.processRequest(plainB);
+    int evWaiter = kiosk.createRequest("EV-WAIT", 1);
+    kiosk.setRequiredAttributes(evWaiter, ATTR_EV_CHARGER);
+    kiosk.processRequest(evWaiter);
+    int plainWaiter = kiosk.createRequest("PLAIN-WAIT", 1);
+    kiosk.processRequest(plainWaiter);
+    kiosk.markVehicleArrived(plainA);
+    kiosk.markVehicleExited(plainA);
+    cout.rdbuf(original);
+    cout << "Plain bay freed: plain waiter served: " 
+         << (kiosk.getRequestById(plainWaiter)->getState() == ALLOCATED ? "YES" : "NO")
+         << ", EV waiter still waiting: " << (kiosk.getWaitlistLength(1) == 1 ? "YES" : "NO") << endl;
+    cout.rdbuf(sink.rdbuf());
+    kiosk.markVehicleArrived(plainB);
+    kiosk.markVehicleExited(plainB);
+    cout.rdbuf(original);
+    cout << "Charger freed: EV waiter served: " 
+         << (kiosk.getRequestById(evWaiter)->getState() == ALLOCATED ? "YES" : "NO") << endl;
+    
+    // Search cost: 60,001 of 65,536 bays taken, a charger on every 8th bay
+    Zone hub(9, "Hub");
+    ParkingArea* deck = new ParkingArea(91, 9, "Deck", 65536);
+    hub.addParkingArea(deck);
+    for (int i = 0; i < 65536; i++) {
+        if (i <= 60000) deck->getSlotByIndex(i)->setStatus(SLOT_OCCUPIED);
+        if (i % 8 == 0) deck->setSlotAttributes(i, ATTR_EV_CHARGER);
+    }
+    const int searches = 10000;
+    ParkingSlot* plainSlot = nullptr;
+    ParkingSlot* chargerSlot = nullptr;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+        plainSlot = hub.findAvailableSlot();
+    }
+    auto plainTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+        chargerSlot = hub.findAvailableSlot(ATTR_EV_CHARGER);
+    }
+    auto chargerTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "First free bay: index " << plainSlot->getSlotIndex() << ", first free charger: index " 
+         << chargerSlot->getSlotIndex() << endl;
+    cout << "Unconstrained search x" << searches << ": " << plainTime << " us" << endl;
+    cout << "EV-constrained search x" << searches << ": " << chargerTime << " us" << endl;
+}
+
+void testContiguousRuns() {
+    cout << "TEST 32: Contiguous Multi-Slot Allocation (Buses, Trailers)" << endl;
+    printSeparator();
+    
+    // Run search: free bays 60-67 straddle a word boundary, 100-299 span several words
+    ParkingArea strip(1, 1, "Strip", 512);
+    for (int i = 0; i < 512; i++) {
+        if ((i < 60 || i >= 68) && (i < 100 || i >= 300)) strip.getSlotByIndex(i)->allocate("CAR");
+    }
+    cout << "Run of 8 at " << strip.findFreeRun(8) << ", run of 9 at " << strip.findFreeRun(9)
+         << ", run of 150 at " << strip.findFreeRun(150) << ", run of 201 at " << strip.findFreeRun(201) << endl;
+    
+    // Depot: a car in every third of the first 150 bays, the last 50 empty
+    ParkingSystem system;
+    Zone* depot = new Zone(1, "Depot");
+    ParkingArea* bays = new ParkingArea(11, 1, "Bus Bays", 200);
+    depot->addParkingArea(bays);
+    Zone* overflow = new Zone(2, "Overflow");
+    overflow->addParkingArea(new ParkingArea(21, 2, "Overflow Lot", 100));
+    system.addZone(depot);
+    system.addZone(overflow);
+    depot->addAdjacentZone(2);
+    overflow->addAdjacentZone(1);
+    for (int i = 0; i < 150; i += 3) {
+        bays->getSlotByIndex(i)->allocate("PARKED");
+    }
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int busId = system.createRequest("BUS-1", 1);
+    system.setRequiredSlots(busId, 4);
+    system.processRequest(busId);
+    int trailerId = system.createRequest("TRAILER-1", 1);
+    system.setRequiredSlots(trailerId, 3);
+    system.processRequest(trailerId);
+    int coachId = system.createRequest("COACH-1", 1);
+    system.setRequiredSlots(coachId, 60);
+    system.processRequest(coachId);
+    cout.rdbuf(original);
+    
+    ParkingRequest* coach = system.getRequestById(coachId);
+    int busFirst = system.getRequestById(busId)->getAllocatedSlotId() - 11000;
+    bool busRun = true;
+    for (int i = busFirst; i < busFirst + 4; i++) {
+        if (strcmp(bays->getSlotByIndex(i)->getAllocatedVehicleId(), "BUS-1") != 0) busRun = false;
+    }
+    cout << "Bus got slot " << system.getRequestById(busId)->getAllocatedSlotId() << " (+3, all its own: " 
+         << (busRun ? "YES" : "NO") << "), trailer got slot " 
+         << system.getRequestById(trailerId)->getAllocatedSlotId() << " (+2)" << endl;
+    cout << "Coach (60 bays) got slot " << coach->getAllocatedSlotId() 
+         << (coach->isCrossZone() ? " (cross-zone)" : "") << ", overflow free: " 
+         << overflow->getOccupancy()->getAvailableSlots() << endl;
+    
+    // Exit and rollback free the whole run
+    cout.rdbuf(sink.rdbuf());
+    system.markVehicleArrived(busId);
+    system.markVehicleExited(busId);
+    int depotFreeAfterExit = depot->getOccupancy()->getAvailableSlots();
+    int bus2Id = system.createRequest("BUS-2", 1);
+    system.setRequiredSlots(bus2Id, 5);
+    system.processRequest(bus2Id);
+    int depotFreeWithBus2 = depot->getOccupancy()->getAvailableSlots();
+    system.rollbackOperations(1);
+    cout.rdbuf(original);
+    cout << "Depot free after bus exit: " << depotFreeAfterExit << ", with 5-bay bus: " << depotFreeWithBus2
+         << ", after rolling it back: " << depot->getOccupancy()->getAvailableSlots() << endl;
+    
+    // A run placed by a zone actor is freed whole when its exit goes through the actors
+    int depotFreeBefore = depot->getOccupancy()->getAvailableSlots();
+    cout.rdbuf(sink.rdbuf());
+    int bus3Id = system.createRequest("BUS-3", 1);
+    system.setRequiredSlots(bus3Id, 6);
+    cout.rdbuf(original);
+    ZoneActorSystem actors(&system);
+    actors.start();
+    actors.allocate(bus3Id);
+    actors.waitIdle();
+    int depotFreeWithBus3 = depot->getOccupancy()->getAvailableSlots();
+    system.markVehicleArrived(bus3Id);
+    actors.exit(bus3Id);
+    actors.stop();
+    cout << "Actor-placed 6-bay bus: depot free " << depotFreeBefore << " -> " << depotFreeWithBus3
+         << " -> " << depot->getOccupancy()->getAvailableSlots() << " after its exit" << endl;
+    
+    // Search cost on a fragmented area: every fifth bay taken, one 14-bay gap near the end
+    ParkingArea yard(9, 9, "Yard", 65536);
+    for (int i = 0; i < 65536; i += 5) {
+        yard.getSlotByIndex(i)->allocate("CAR");
+    }
+    yard.getSlotByIndex(65520)->release();
+    yard.getSlotByIndex(65525)->release();
+    const int searches = 1000;
+    int first = -1;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < searches; i++) {
+        first = yard.findFreeRun(6);
+    }
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "Run of 6 in the fragmented yard at " << first << endl;
+    cout << "Run search x" << searches << ": " << elapsed << " us" << endl;
+}
+
+// Shared harness for every SlotSelector: fill a 4,096-slot, 8-level zone to
+// 90%, then churn (release a random held slot, select a new one) with a fixed seed
+template <class Selector>
+void benchmarkSlotSelector(const char* name) {
+    const int levels = 8;
+    const int perLevel = 512;
+    const int capacity = levels * perLevel;
+    const int churn = 100000;
+    Zone zone(1, "Bench");
+    for (int a = 0; a < levels; a++) {
+        zone.addParkingArea(new ParkingArea(10 + a, 1, "Level", perLevel));
+    }
+    
+    ParkingSlot** held = new ParkingSlot*[capacity];
+    bool* touched = new bool[capacity];
+    for (int i = 0; i < capacity; i++) {
+        touched[i] = false;
+    }
+    int heldCount = 0;
+    unsigned int seed = 12345;
+    
+    auto start = chrono::steady_clock::now();
+    for (int step = 0; step < capacity * 9 / 10 + churn; step++) {
+        if (heldCount >= capacity * 9 / 10) {
+            seed = seed * 1103515245u + 12345u;
+            int victim = (int)((seed >> 8) % (unsigned int)heldCount);
+            held[victim]->release();
+            held[victim] = held[--heldCount];
+        }
+        ParkingSlot* slot = Selector::select(&zone, 0);
+        slot->allocate("BENCH");
+        held[heldCount++] = slot;
+        touched[(slot->getAreaId() - 10) * perLevel + slot->getSlotIndex()] = true;
+    }
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    
+    int touchedCount = 0;
+    for (int i = 0; i < capacity; i++) {
+        if (touched[i]) touchedCount++;
+    }
+    float lowest = 1.0f;
+    float highest = 0.0f;
+    for (int a = 0; a < levels; a++) {
+        float utilization = zone.getAreaByIndex(a)->getUtilization();
+        if (utilization < lowest) lowest = utilization;
+        if (utilization > highest) highest = utilization;
+    }
+    cout << "  " << name << ": level utilization spread " << (int)((highest - lowest) * 100 + 0.5f) 
+         << "%, slots ever used " << touchedCount << " of " << capacity << endl;
+    cout << "  " << name << " churn x" << churn << ": " << elapsed << " us" << endl;
+    delete[] held;
+    delete[] touched;
+}
+
+void testAllocationPolicies() {
+    cout << "TEST 33: Allocation Policies (Slot Selection and Fallback Order)" << endl;
+    printSeparator();
+    
+    cout << "Benchmark (same workload per selector):" << endl;
+    benchmarkSlotSelector<FirstFitSelector>("First-fit");
+    benchmarkSlotSelector<NextFitSelector>("Next-fit");
+    benchmarkSlotSelector<LeastUtilizedSelector>("Least-utilized area");
+    benchmarkSlotSelector<RoundRobinSelector>("Round-robin areas");
+    
+    // Engine policy: four single requests land on four different levels
+    ParkingSystem system;
+    Zone* garage = new Zone(1, "Garage");
+    for (int a = 0; a < 4; a++) {
+        garage->addParkingArea(new ParkingArea(11 + a, 1, "Level", 10));
+    }
+    Zone* nearLot = new Zone(2, "Near Lot");
+    nearLot->addParkingArea(new ParkingArea(21, 2, "Near", 10));
+    Zone* farLot = new Zone(3, "Far Lot");
+    farLot->addParkingArea(new ParkingArea(31, 3, "Far", 10));
+    system.addZone(garage);
+    system.addZone(nearLot);
+    system.addZone(farLot);
+    garage->addAdjacentZone(2, 1);
+    garage->addAdjacentZone(3, 2);
+    system.getAllocationEngine()->setSlotPolicy(POLICY_ROUND_ROBIN_AREAS);
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    int levelsUsed[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "RR%d", i);
+        int requestId = system.createRequest(vehicleId, 1);
+        system.processRequest(requestId);
+        levelsUsed[system.getRequestById(requestId)->getAllocatedSlotId() / 1000 - 11]++;
+    }
+    cout.rdbuf(original);
+    cout << "Round-robin requests per level: " << levelsUsed[0] << " " << levelsUsed[1] << " " 
+         << levelsUsed[2] << " " << levelsUsed[3] << endl;
+    
+    // Zone actors claim through the same policy
+    ParkingSystem deck;
+    Zone* deckGarage = new Zone(1, "Deck");
+    for (int a = 0; a < 4; a++) {
+        deckGarage->addParkingArea(new ParkingArea(11 + a, 1, "Level", 10));
+    }
+    deck.addZone(deckGarage);
+    deck.getAllocationEngine()->setSlotPolicy(POLICY_ROUND_ROBIN_AREAS);
+    int deckIds[4];
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 4; i++) {
+        char vehicleId[20];
+        sprintf(vehicleId, "DECK%d", i);
+        deckIds[i] = deck.createRequest(vehicleId, 1);
+    }
+    cout.rdbuf(original);
+    ZoneActorSystem deckActors(&deck);
+    deckActors.start();
+    for (int i = 0; i < 4; i++) {
+        deckActors.allocate(deckIds[i]);
+    }
+    deckActors.stop();
+    int actorLevels[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        ParkingRequest* request = deck.getRequestById(deckIds[i]);
+        if (request->getState() == ALLOCATED) actorLevels[request->getAllocatedSlotId() / 1000 - 11]++;
+    }
+    cout << "Round-robin actor requests per level: " << actorLevels[0] << " " << actorLevels[1] << " " 
+         << actorLevels[2] << " " << actorLevels[3] << endl;
+    
+    // Fallback policy: garage full, the near lot 80% full, the far lot empty
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 36; i++) {
+        system.processRequest(system.createRequest("FILL", 1));
+    }
+    for (int i = 0; i < 8; i++) {
+        system.processRequest(system.createRequest("NEARBY", 2));
+    }
+    int nearestId = system.createRequest("OVERFLOW-1", 1);
+    system.processRequest(nearestId);
+    system.getAllocationEngine()->setFallbackPolicy(FALLBACK_LEAST_UTILIZED);
+    int emptiestId = system.createRequest("OVERFLOW-2", 1);
+    system.processRequest(emptiestId);
+    cout.rdbuf(original);
+    cout << "Nearest fallback sent overflow to zone " 
+         << system.findSlotByHandle(system.getRequestById(nearestId)->getAllocatedSlotHandle())->getZoneId()
+         << ", least-utilized fallback to zone "
+         << system.findSlotByHandle(system.getRequestById(emptiestId)->getAllocatedSlotHandle())->getZoneId() << endl;
+}
+
+// One EV arrival per round at the full stadium; each round one plain car also
+// leaves the north lot and another takes its bay (a fresh free epoch there)
+int runFallbackRounds(ParkingSystem& system, int* northIds, int rounds) {
+    int crossZone = 0;
+    for (int r = 0; r < rounds; r++) {
+        int evId = system.createRequest("EV", 1);
+        system.setRequiredAttributes(evId, ATTR_EV_CHARGER);
+        if (system.processRequest(evId) && system.getRequestById(evId)->isCrossZone()) {
+            crossZone++;
+        }
+        system.cancelRequest(northIds[r % 10]);
+        northIds[r % 10] = system.createRequest("NORTH", 2);
+        system.processRequest(northIds[r % 10]);
+    }
+    return crossZone;
+}
+
+void testAdaptiveFallback() {
+    cout << "TEST 34: Adaptive Fallback Order and Negative Cache" << endl;
+    printSeparator();
+    
+    // Stadium (full) falls back to two near lots without chargers, then a far charging hub
+    ParkingSystem system;
+    Zone* stadium = new Zone(1, "Stadium");
+    stadium->addParkingArea(new ParkingArea(11, 1, "Stadium Lot", 20));
+    Zone* north = new Zone(2, "North Lot");
+    north->addParkingArea(new ParkingArea(21, 2, "North", 40));
+    Zone* south = new Zone(3, "South Lot");
+    south->addParkingArea(new ParkingArea(31, 3, "South", 40));
+    Zone* hub = new Zone(4, "Charging Hub");
+    hub->addParkingArea(new ParkingArea(41, 4, "Hub", 60));
+    system.addZone(stadium);
+    system.addZone(north);
+    system.addZone(south);
+    system.addZone(hub);
+    stadium->addAdjacentZone(2, 1);
+    stadium->addAdjacentZone(3, 2);
+    stadium->addAdjacentZone(4, 3);
+    for (int i = 0; i < 60; i++) {
+        system.setSlotAttributes(41000 + i, ATTR_EV_CHARGER);
+    }
+    AllocationEngine* engine = system.getAllocationEngine();
+    engine->setFallbackHour(17);
+    
+    streambuf* original = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    for (int i = 0; i < 20; i++) {
+        system.processRequest(system.createRequest("FAN", 1));
+    }
+    int northIds[10];
+    int southIds[10];
+    for (int i = 0; i < 10; i++) {
+        northIds[i] = system.createRequest("NORTH", 2);
+        system.processRequest(northIds[i]);
+        southIds[i] = system.createRequest("SOUTH", 3);
+        system.processRequest(southIds[i]);
+    }
+    cout.rdbuf(original);
+    
+    // Nearest order: the churning north lot is searched every round, the
+    // quiet south lot only until its miss is cached
+    cout.rdbuf(sink.rdbuf());
+    int nearestAllocated = runFallbackRounds(system, northIds, 20);
+    cout.rdbuf(original);
+    long long nearestWasted = engine->getWastedProbes();
+    cout << "Nearest:  " << nearestAllocated << " cross-zone EV allocations, " << nearestWasted
+         << " wasted probes (" << (float)nearestWasted / nearestAllocated << " per allocation), "
+         << engine->getNegativeCacheSkips() << " negative-cache skips" << endl;
+    
+    bool cachedMiss = south->isKnownMiss(ATTR_EV_CHARGER);
+    cout.rdbuf(sink.rdbuf());
+    system.cancelRequest(southIds[0]);
+    cout.rdbuf(original);
+    cout << "South lot EV miss cached: " << (cachedMiss ? "YES" : "NO") 
+         << ", after a release there: " << (south->isKnownMiss(ATTR_EV_CHARGER) ? "YES" : "NO") << endl;
+    
+    // Adaptive order learns from scratch at the same hour
+    engine->clearFallbackStats();
+    engine->setFallbackPolicy(FALLBACK_ADAPTIVE);
+    cout.rdbuf(sink.rdbuf());
+    int adaptiveAllocated = runFallbackRounds(system, northIds, 20);
+    cout.rdbuf(original);
+    long long adaptiveWasted = engine->getWastedProbes();
+    cout << "Adaptive: " << adaptiveAllocated << " cross-zone EV allocations, " << adaptiveWasted
+         << " wasted probes (" << (float)adaptiveWasted / adaptiveAllocated << " per allocation), "
+         << engine->getNegativeCacheSkips() << " negative-cache skips" << endl;
+    
+    DynamicArray<int> peakOrder;
+    DynamicArray<int> quietOrder;
+    engine->getLearnedFallbackOrder(1, 17, peakOrder);
+    engine->getLearnedFallbackOrder(1, 3, quietOrder);
+    cout << "Stadium fallback order at 17:00:";
+    for (int i = 0; i < peakOrder.getSize(); i++) {
+        cout << " " << peakOrder[i];
+    }
+    cout << ", at 03:00 (no history):";
+    for (int i = 0; i < quietOrder.getSize(); i++) {
+        cout << " " << quietOrder[i];
+    }
+    cout << endl;
+}
+
 int main() {
     cout << "\n**************************************************" << endl;
     cout << "*  SMART PARKING MANAGEMENT SYSTEM - TEST SUITE  *" << endl;
@@ -293,6 +2443,30 @@ int main() {
     testZoneUtilization(parkingSystem);
     testMultipleZones(parkingSystem);
     testEdgeCases(parkingSystem);
+    testSlotSearchModes();
+    testSlotDirectory();
+    testVehicleIndex();
+    testRequestRecycling();
+    testSlotTableStartup();
+    testSlotKernels();
+    testVehicleIdPool();
+    testOccupancyCounters();
+    testBatchAllocation();
+    testMultiHopFallback();
+    testMinCostBatch();
+    testConcurrentAllocation();
+    testGateIngestion();
+    testWorkStealingPool();
+    testZoneActors();
+    testNoShowExpiry();
+    testOverstayDetection();
+    testWaitlistHandoff();
+    testPriorityClasses();
+    testAdvanceReservations();
+    testAttributeAllocation();
+    testContiguousRuns();
+    testAllocationPolicies();
+    testAdaptiveFallback();
     
     // Final system status
     printSeparator();